@@ -0,0 +1,632 @@
+#define _POSIX_C_SOURCE 200809L
+// FOR wait4()
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <dirent.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+// BENCHMARK HARNESS: RUNS THE SOLVER ON GENERATED INSTANCES (OR ON THE CNF
+// FILES OF THE GIVEN DIRECTORIES) WITH A TIMEOUT, CHECKS EVERY ANSWER AND
+// WRITES ONE CSV LINE PER INSTANCE, THEN PRINTS THE PAR-2 SCORE.
+// AN INSTANCE MAY STATE ITS ANSWER IN A "c expect SAT" OR "c expect UNSAT"
+// COMMENT, THE GENERATED ONES DO WHEN IT IS KNOWN. SAT ANSWERS ARE CHECKED
+// AGAINST THE FORMULA, UNSAT ONES AGAINST THE EXPECTATION
+
+// --- ANSWERS ---
+#define ANSWER_UNKNOWN 0
+#define ANSWER_SAT 10
+#define ANSWER_UNSAT 20
+
+// --- SIZE OF THE BUFFER FOR THE SOLVER'S OUTPUT ---
+#define OUTPUT_SIZE (1 << 16)
+
+// ONE RUN OF THE SOLVER
+typedef struct run_result {
+    int answer;
+    int timed_out;
+    double seconds;
+    long long conflicts;
+    long long decisions;
+    long long propagations;
+    long peak_rss_kb;
+} run_result;
+
+// GROWABLE LIST OF FILE NAMES
+typedef struct name_list {
+    char** names;
+    int size;
+    int capacity;
+} name_list;
+
+// STATE OF THE RANDOM NUMBER GENERATOR OF THE GENERATORS (xorshift64*)
+static unsigned long long random_state;
+
+unsigned int next_random(void) {
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+    return (random_state * 0x2545f4914f6cdd1dULL) >> 32;
+}
+
+void push_name(name_list* list, const char* name) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity == 0 ? 16 : 2 * list->capacity;
+        list->names = (realloc(list->names, list->capacity * sizeof(char*)));
+    }
+    list->names[list->size] = (strdup(name));
+    list->size++;
+}
+
+int compare_names(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// ---GENERATORS---
+// EVERY GENERATOR WRITES ONE INSTANCE TO path. THE CLAUSES ARE WRITTEN TO A
+// TEMPORARY FILE FIRST, SINCE THE HEADER NEEDS THEIR COUNT
+
+FILE* begin_instance(void) {
+    return tmpfile();
+}
+
+void end_instance(FILE* body, const char* path, int num_variables,
+        int num_clauses, int expected) {
+    FILE* out = fopen(path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "cannot write %s\n", path);
+        exit(1);
+    }
+    if (expected != ANSWER_UNKNOWN) {
+        fprintf(out, "c expect %s\n",
+                expected == ANSWER_SAT ? "SAT" : "UNSAT");
+    }
+    fprintf(out, "p cnf %d %d\n", num_variables, num_clauses);
+
+    char buffer[1 << 14];
+    size_t got;
+    rewind(body);
+    while ((got = fread(buffer, 1, sizeof(buffer), body)) > 0) {
+        fwrite(buffer, 1, got, out);
+    }
+    fclose(body);
+    fclose(out);
+}
+
+// RANDOM k-SAT WITH num_clauses CLAUSES OF k DIFFERENT VARIABLES
+void generate_random_ksat(const char* path, int k, int num_variables,
+        int num_clauses) {
+    FILE* body = begin_instance();
+    int* chosen = (malloc(sizeof(int) * k));
+    for (int c = 0; c < num_clauses; c++) {
+        for (int i = 0; i < k; i++) {
+            int repeated;
+            do {
+                chosen[i] = next_random() % num_variables + 1;
+                repeated = 0;
+                for (int j = 0; j < i; j++) {
+                    repeated |= chosen[j] == chosen[i];
+                }
+            } while (repeated);
+            fprintf(body, "%d ", next_random() & 1 ? chosen[i] : -chosen[i]);
+        }
+        fprintf(body, "0\n");
+    }
+    free(chosen);
+    end_instance(body, path, num_variables, num_clauses, ANSWER_UNKNOWN);
+}
+
+// holes + 1 PIGEONS IN holes HOLES, ALWAYS UNSAT.
+// VARIABLE p * holes + h + 1 MEANS PIGEON p SITS IN HOLE h
+void generate_pigeonhole(const char* path, int holes) {
+    FILE* body = begin_instance();
+    int num_clauses = 0;
+    for (int p = 0; p <= holes; p++) {
+        for (int h = 0; h < holes; h++) {
+            fprintf(body, "%d ", p * holes + h + 1);
+        }
+        fprintf(body, "0\n");
+        num_clauses++;
+    }
+    for (int h = 0; h < holes; h++) {
+        for (int p = 0; p <= holes; p++) {
+            for (int q = p + 1; q <= holes; q++) {
+                fprintf(body, "-%d -%d 0\n", p * holes + h + 1,
+                        q * holes + h + 1);
+                num_clauses++;
+            }
+        }
+    }
+    end_instance(body, path, (holes + 1) * holes, num_clauses, ANSWER_UNSAT);
+}
+
+// CLAUSES OF out == a XOR b
+int write_xor(FILE* body, int out, int a, int b) {
+    fprintf(body, "-%d %d %d 0\n", out, a, b);
+    fprintf(body, "-%d -%d -%d 0\n", out, a, b);
+    fprintf(body, "%d -%d %d 0\n", out, a, b);
+    fprintf(body, "%d %d -%d 0\n", out, a, b);
+    return 4;
+}
+
+// THE PARITY OF num_inputs VARIABLES IS COMPUTED TWICE, BY XOR CHAINS OVER
+// TWO DIFFERENT RANDOM ORDERS OF THEM. THE TWO RESULTS ARE REQUIRED TO BE
+// EQUAL (SAT) OR DIFFERENT (UNSAT), WHICH IS HARD FOR RESOLUTION
+void generate_parity(const char* path, int num_inputs, int satisfiable) {
+    FILE* body = begin_instance();
+    int* order = (malloc(sizeof(int) * num_inputs));
+    int next_variable = num_inputs + 1;
+    int results[2];
+    int num_clauses = 0;
+
+    for (int chain = 0; chain < 2; chain++) {
+        for (int i = 0; i < num_inputs; i++) order[i] = i + 1;
+        for (int i = num_inputs - 1; i > 0; i--) {
+            int j = next_random() % (i + 1);
+            int tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+
+        int previous = order[0];
+        for (int i = 1; i < num_inputs; i++) {
+            num_clauses += write_xor(body, next_variable, previous, order[i]);
+            previous = next_variable;
+            next_variable++;
+        }
+        results[chain] = previous;
+    }
+    free(order);
+
+    int r = results[0];
+    int q = results[1];
+    if (satisfiable) {
+        fprintf(body, "-%d %d 0\n%d -%d 0\n", r, q, r, q);
+    }
+    else fprintf(body, "%d %d 0\n-%d -%d 0\n", r, q, r, q);
+    num_clauses += 2;
+
+    end_instance(body, path, next_variable - 1, num_clauses,
+            satisfiable ? ANSWER_SAT : ANSWER_UNSAT);
+}
+
+// COLOR A RANDOM GRAPH OF num_vertices VERTICES AND num_edges EDGES WITH
+// colors COLORS. VARIABLE v * colors + c + 1 MEANS VERTEX v HAS COLOR c
+void generate_coloring(const char* path, int num_vertices, int num_edges,
+        int colors) {
+    FILE* body = begin_instance();
+    int num_clauses = 0;
+    for (int v = 0; v < num_vertices; v++) {
+        for (int c = 0; c < colors; c++) {
+            fprintf(body, "%d ", v * colors + c + 1);
+        }
+        fprintf(body, "0\n");
+        num_clauses++;
+        for (int c = 0; c < colors; c++) {
+            for (int d = c + 1; d < colors; d++) {
+                fprintf(body, "-%d -%d 0\n", v * colors + c + 1,
+                        v * colors + d + 1);
+                num_clauses++;
+            }
+        }
+    }
+    for (int e = 0; e < num_edges; e++) {
+        int u = next_random() % num_vertices;
+        int v = next_random() % num_vertices;
+        if (u == v) {
+            e--;
+            continue;
+        }
+        for (int c = 0; c < colors; c++) {
+            fprintf(body, "-%d -%d 0\n", u * colors + c + 1,
+                    v * colors + c + 1);
+            num_clauses++;
+        }
+    }
+    end_instance(body, path, num_vertices * colors, num_clauses,
+            ANSWER_UNKNOWN);
+}
+
+// WRITE THE WHOLE GENERATED SUITE TO directory AND LIST THE FILES
+void generate_suite(const char* directory, unsigned long long seed,
+        name_list* files) {
+    char path[4096];
+    mkdir(directory, 0755);
+    random_state = seed * 0x9e3779b97f4a7c15ULL + 1;
+
+    // 3-SAT AT THE PHASE TRANSITION (4.26 CLAUSES PER VARIABLE)
+    static const int ksat_sizes[] = {150, 200, 250};
+    for (int i = 0; i < 3; i++) {
+        for (int copy = 1; copy <= 3; copy++) {
+            snprintf(path, sizeof(path), "%s/random3-n%d-%d.cnf", directory,
+                    ksat_sizes[i], copy);
+            generate_random_ksat(path, 3, ksat_sizes[i],
+                    (int)(4.26 * ksat_sizes[i]));
+            push_name(files, path);
+        }
+    }
+
+    for (int holes = 7; holes <= 9; holes++) {
+        snprintf(path, sizeof(path), "%s/pigeonhole-%d.cnf", directory, holes);
+        generate_pigeonhole(path, holes);
+        push_name(files, path);
+    }
+
+    static const int parity_sizes[] = {24, 28, 32};
+    for (int i = 0; i < 3; i++) {
+        for (int satisfiable = 0; satisfiable < 2; satisfiable++) {
+            snprintf(path, sizeof(path), "%s/parity-n%d-%s.cnf", directory,
+                    parity_sizes[i], satisfiable ? "sat" : "unsat");
+            generate_parity(path, parity_sizes[i], satisfiable);
+            push_name(files, path);
+        }
+    }
+
+    // 3-COLORING AROUND ITS THRESHOLD (AVERAGE DEGREE ABOUT 4.6)
+    static const int coloring_sizes[] = {200, 300, 400};
+    for (int i = 0; i < 3; i++) {
+        for (int copy = 1; copy <= 2; copy++) {
+            snprintf(path, sizeof(path), "%s/coloring3-n%d-%d.cnf", directory,
+                    coloring_sizes[i], copy);
+            generate_coloring(path, coloring_sizes[i],
+                    (int)(2.3 * coloring_sizes[i]), 3);
+            push_name(files, path);
+        }
+    }
+}
+
+// ADD EVERY CNF FILE (POSSIBLY COMPRESSED) OF directory, IN NAME ORDER
+void list_directory(const char* directory, name_list* files) {
+    DIR* dir = opendir(directory);
+    if (dir == NULL) {
+        fprintf(stderr, "cannot open directory %s\n", directory);
+        exit(1);
+    }
+    int first = files->size;
+    char path[4096];
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const char* name = entry->d_name;
+        if (strstr(name, ".cnf") == NULL) continue;
+        snprintf(path, sizeof(path), "%s/%s", directory, name);
+        push_name(files, path);
+    }
+    closedir(dir);
+    qsort(files->names + first, files->size - first, sizeof(char*),
+            compare_names);
+}
+
+// ---CHECKING---
+
+// OPEN A CNF FILE FOR READING, THROUGH THE DECOMPRESSOR IF IT IS COMPRESSED.
+// *piped TELLS HOW TO CLOSE IT
+FILE* open_cnf(const char* path, int* piped) {
+    static const char* extensions[] = {".gz", ".xz", ".bz2"};
+    static const char* tools[] = {"gzip", "xz", "bzip2"};
+    size_t length = strlen(path);
+    for (int i = 0; i < 3; i++) {
+        size_t extension_length = strlen(extensions[i]);
+        if (length > extension_length &&
+                !strcmp(path + length - extension_length, extensions[i])) {
+            char command[4200];
+            snprintf(command, sizeof(command), "%s -dc '%s'", tools[i], path);
+            *piped = 1;
+            return popen(command, "r");
+        }
+    }
+    *piped = 0;
+    return fopen(path, "r");
+}
+
+void close_cnf(FILE* file, int piped) {
+    if (piped) pclose(file);
+    else fclose(file);
+}
+
+// THE ANSWER THE "c expect" COMMENT OF THE INSTANCE STATES
+int expected_answer(const char* path) {
+    int piped;
+    FILE* file = open_cnf(path, &piped);
+    if (file == NULL) return ANSWER_UNKNOWN;
+
+    int expected = ANSWER_UNKNOWN;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != NULL && line[0] == 'c') {
+        if (!strncmp(line, "c expect UNSAT", 14)) expected = ANSWER_UNSAT;
+        else if (!strncmp(line, "c expect SAT", 12)) expected = ANSWER_SAT;
+    }
+    close_cnf(file, piped);
+    return expected;
+}
+
+// CHECK THAT THE MODEL IN solution_path SATISFIES EVERY CLAUSE OF THE CNF
+int model_satisfies(const char* cnf_path, const char* solution_path) {
+    FILE* solution = fopen(solution_path, "r");
+    if (solution == NULL) return 0;
+
+    // THE VALUES ARE INDEXED BY VARIABLE: 1 TRUE, 0 FALSE
+    char* values = NULL;
+    int values_size = 0;
+    char token[64];
+    while (fscanf(solution, "%63s", token) == 1) {
+        char* end;
+        long literal = strtol(token, &end, 10);
+        if (*end != '\0' || literal == 0) continue;
+        long variable_id = labs(literal);
+        if (variable_id >= values_size) {
+            int new_size = 2 * (int)variable_id + 1;
+            values = (realloc(values, new_size));
+            memset(values + values_size, 0, new_size - values_size);
+            values_size = new_size;
+        }
+        values[variable_id] = literal > 0;
+    }
+    fclose(solution);
+
+    int piped;
+    FILE* cnf = open_cnf(cnf_path, &piped);
+    if (cnf == NULL) {
+        free(values);
+        return 0;
+    }
+
+    // A CLAUSE MAY SPAN SEVERAL LINES, satisfied IS KEPT UNTIL ITS 0
+    int ok = 1;
+    int satisfied = 0;
+    char* line = NULL;
+    size_t line_capacity = 0;
+    while (ok && getline(&line, &line_capacity, cnf) > 0) {
+        if (line[0] == 'c' || line[0] == 'p') continue;
+        if (line[0] == '%') break;
+
+        char* pos = line;
+        while (1) {
+            char* end;
+            long literal = strtol(pos, &end, 10);
+            if (end == pos) break;
+            pos = end;
+
+            if (literal == 0) {
+                ok &= satisfied;
+                satisfied = 0;
+            }
+            else if (labs(literal) < values_size &&
+                    values[labs(literal)] == (literal > 0)) {
+                satisfied = 1;
+            }
+        }
+    }
+    free(line);
+    close_cnf(cnf, piped);
+    free(values);
+    return ok;
+}
+
+// ---RUNNING---
+
+double seconds_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// VALUE OF THE "name: VALUE" LINE OF THE SOLVER'S OUTPUT, 0 IF MISSING
+long long output_counter(const char* output, const char* name) {
+    const char* line = strstr(output, name);
+    if (line == NULL) return 0;
+    return atoll(line + strlen(name));
+}
+
+// RUN THE SOLVER ON cnf_path, KILLING IT AFTER timeout SECONDS. ITS OUTPUT
+// IS COLLECTED THROUGH A PIPE, THE PEAK RSS COMES FROM wait4()
+run_result run_solver(const char* solver, char** solver_args, int num_args,
+        const char* cnf_path, const char* solution_path, double timeout) {
+    run_result result;
+    memset(&result, 0, sizeof(result));
+
+    int output_pipe[2];
+    if (pipe(output_pipe) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+
+    double start = seconds_now();
+    pid_t child = fork();
+    if (child == 0) {
+        dup2(output_pipe[1], STDOUT_FILENO);
+        close(output_pipe[0]);
+        close(output_pipe[1]);
+
+        const char** argv = (malloc(sizeof(char*) * (num_args + 4)));
+        argv[0] = solver;
+        for (int i = 0; i < num_args; i++) argv[i + 1] = solver_args[i];
+        argv[num_args + 1] = cnf_path;
+        argv[num_args + 2] = solution_path;
+        argv[num_args + 3] = NULL;
+        execv(solver, (char* const*)argv);
+        perror(solver);
+        _exit(127);
+    }
+    close(output_pipe[1]);
+
+    // READ UNTIL THE SOLVER CLOSES ITS OUTPUT OR RUNS OUT OF TIME.
+    // ONLY THE END OF A LONG OUTPUT IS KEPT, THAT IS WHERE THE COUNTERS ARE
+    char* output = (malloc(OUTPUT_SIZE + 1));
+    int output_size = 0;
+    while (1) {
+        double left = start + timeout - seconds_now();
+        if (left <= 0) {
+            result.timed_out = 1;
+            break;
+        }
+        struct pollfd waiting = {output_pipe[0], POLLIN, 0};
+        int ready = poll(&waiting, 1, (int)(left * 1000) + 1);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) continue;
+
+        if (output_size == OUTPUT_SIZE) {
+            memmove(output, output + OUTPUT_SIZE / 2, OUTPUT_SIZE / 2);
+            output_size = OUTPUT_SIZE / 2;
+        }
+        ssize_t got = read(output_pipe[0], output + output_size,
+                OUTPUT_SIZE - output_size);
+        if (got <= 0) break;
+        output_size += got;
+    }
+    output[output_size] = '\0';
+    close(output_pipe[0]);
+
+    if (result.timed_out) kill(child, SIGKILL);
+    int status;
+    struct rusage usage;
+    wait4(child, &status, 0, &usage);
+    result.seconds = seconds_now() - start;
+    result.peak_rss_kb = usage.ru_maxrss;
+
+    if (!result.timed_out) {
+        if (strstr(output, "UNSATISFIABLE") != NULL) {
+            result.answer = ANSWER_UNSAT;
+        }
+        else if (strstr(output, "SATISFIABLE") != NULL) {
+            result.answer = ANSWER_SAT;
+        }
+    }
+    result.conflicts = output_counter(output, "c conflicts: ");
+    result.decisions = output_counter(output, "c decisions: ");
+    result.propagations = output_counter(output, "c propagations: ");
+    free(output);
+    return result;
+}
+
+// ----------------
+// ------MAIN------
+// ----------------
+int main(int argc, char* argv[]) {
+    const char* solver = "./somesat";
+    const char* csv_path = "bench.csv";
+    const char* suite_directory = "bench_instances";
+    double timeout = 60;
+    unsigned long long seed = 1;
+    char** solver_args = (malloc(sizeof(char*) * argc));
+    int num_args = 0;
+    name_list directories = {NULL, 0, 0};
+
+    for (int i = 1; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--solver") && has_value) solver = argv[++i];
+        else if (!strcmp(argv[i], "--timeout") && has_value) {
+            timeout = atof(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--csv") && has_value) csv_path = argv[++i];
+        else if (!strcmp(argv[i], "--seed") && has_value) {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "--generate") && has_value) {
+            suite_directory = argv[++i];
+        }
+        // EVERYTHING AFTER -- GOES TO THE SOLVER
+        else if (!strcmp(argv[i], "--")) {
+            for (i++; i < argc; i++) {
+                solver_args[num_args] = argv[i];
+                num_args++;
+            }
+        }
+        else if (!strncmp(argv[i], "--", 2)) {
+            fprintf(stderr, "usage: somesat-bench [--solver PATH] "
+                    "[--timeout SECONDS] [--csv PATH] [--seed N]\n"
+                    "                     [--generate DIRECTORY] "
+                    "[cnf_directory...] [-- solver options]\n");
+            return 1;
+        }
+        else push_name(&directories, argv[i]);
+    }
+
+    if (timeout <= 0) {
+        fprintf(stderr, "--timeout needs a positive number\n");
+        return 1;
+    }
+
+    // THE GENERATED SUITE IS USED UNLESS DIRECTORIES ARE GIVEN
+    name_list files = {NULL, 0, 0};
+    if (directories.size == 0) generate_suite(suite_directory, seed, &files);
+    for (int i = 0; i < directories.size; i++) {
+        list_directory(directories.names[i], &files);
+    }
+
+    FILE* csv = fopen(csv_path, "w");
+    if (csv == NULL) {
+        fprintf(stderr, "cannot write %s\n", csv_path);
+        return 1;
+    }
+    fprintf(csv, "instance,expected,answer,verified,seconds,conflicts,"
+            "decisions,propagations,peak_rss_kb\n");
+
+    char solution_path[] = "/tmp/somesat-bench-XXXXXX";
+    int solution_fd = mkstemp(solution_path);
+    if (solution_fd < 0) {
+        perror("mkstemp");
+        return 1;
+    }
+    close(solution_fd);
+
+    // PAR-2: THE TIME OF EVERY CORRECTLY SOLVED INSTANCE, TWICE THE TIMEOUT
+    // FOR ALL THE OTHERS
+    double par2 = 0;
+    int solved = 0;
+    int wrong = 0;
+    for (int i = 0; i < files.size; i++) {
+        const char* cnf_path = files.names[i];
+        int expected = expected_answer(cnf_path);
+        remove(solution_path);
+        run_result result = run_solver(solver, solver_args, num_args,
+                cnf_path, solution_path, timeout);
+
+        const char* verified = "no";
+        if (result.answer == ANSWER_SAT) {
+            int ok = expected != ANSWER_UNSAT &&
+                model_satisfies(cnf_path, solution_path);
+            verified = ok ? "yes" : "WRONG";
+        }
+        else if (result.answer == ANSWER_UNSAT) {
+            if (expected == ANSWER_UNSAT) verified = "yes";
+            else if (expected == ANSWER_SAT) verified = "WRONG";
+            else verified = "unknown";
+        }
+
+        if (!strcmp(verified, "WRONG")) wrong++;
+        if (result.answer != ANSWER_UNKNOWN && strcmp(verified, "WRONG")) {
+            solved++;
+            par2 += result.seconds;
+        }
+        else par2 += 2 * timeout;
+
+        static const char* answers[] = {"", "SAT", "UNSAT"};
+        const char* answer = result.timed_out ? "TIMEOUT" :
+            result.answer == ANSWER_UNKNOWN ? "ERROR" :
+            answers[result.answer / 10];
+        fprintf(csv, "%s,%s,%s,%s,%.3f,%lld,%lld,%lld,%ld\n", cnf_path,
+                expected == ANSWER_UNKNOWN ? "" : answers[expected / 10],
+                answer, verified, result.seconds, result.conflicts,
+                result.decisions, result.propagations, result.peak_rss_kb);
+        fflush(csv);
+        printf("%-40s %-8s %-8s %8.2fs\n", cnf_path, answer, verified,
+                result.seconds);
+        fflush(stdout);
+    }
+    fclose(csv);
+    remove(solution_path);
+
+    printf("solved %d of %d, wrong %d, PAR-2 %.2f (total %.2f)\n", solved,
+            files.size, wrong, files.size > 0 ? par2 / files.size : 0.0, par2);
+    return wrong > 0;
+}
@@ -0,0 +1,99 @@
+#include <stdlib.h>
+
+#include "solver.h"
+#include "ipasir.h"
+
+// ONLY THE IPASIR FUNCTIONS ARE EXPORTED FROM THE SHARED LIBRARY
+#define EXPORT __attribute__((visibility("default")))
+
+// THE SOLVER AND WHAT IPASIR COLLECTS FOR IT BETWEEN TWO CALLS: THE CLAUSE
+// BEING ADDED AND THE ASSUMPTIONS OF THE NEXT SEARCH
+typedef struct incremental_solver {
+    solver* s;
+    watch_list clause;
+    watch_list assumptions;
+} incremental_solver;
+
+EXPORT const char* ipasir_signature(void) {
+    return "someSAT";
+}
+
+// THERE IS NO PREPROCESSING, IT COULD ELIMINATE VARIABLES THAT LATER
+// CLAUSES STILL USE
+EXPORT void* ipasir_init(void) {
+    incremental_solver* wrapper = (calloc(1, sizeof(incremental_solver)));
+    wrapper->s = new_solver();
+    return wrapper;
+}
+
+EXPORT void ipasir_release(void* handle) {
+    incremental_solver* wrapper = handle;
+    free_solver(wrapper->s);
+    free(wrapper->clause.clause_refs);
+    free(wrapper->assumptions.clause_refs);
+    free(wrapper);
+}
+
+EXPORT void ipasir_add(void* handle, int32_t lit_or_zero) {
+    incremental_solver* wrapper = handle;
+    if (lit_or_zero != 0) {
+        add_variables(wrapper->s, abs(lit_or_zero));
+        push_int(&wrapper->clause, lit_or_zero);
+        return;
+    }
+    add_clause(wrapper->s, wrapper->clause.clause_refs, wrapper->clause.size);
+    wrapper->clause.size = 0;
+}
+
+EXPORT void ipasir_assume(void* handle, int32_t lit) {
+    incremental_solver* wrapper = handle;
+    add_variables(wrapper->s, abs(lit));
+    push_int(&wrapper->assumptions, lit);
+}
+
+EXPORT int ipasir_solve(void* handle) {
+    incremental_solver* wrapper = handle;
+    solver* s = wrapper->s;
+    s->assumptions = wrapper->assumptions.clause_refs;
+    s->assumption_count = wrapper->assumptions.size;
+
+    int result = decide(s);
+
+    s->assumptions = NULL;
+    s->assumption_count = 0;
+    wrapper->assumptions.size = 0;
+    if (result == SEARCH_STOPPED) return 0;
+    return result ? 10 : 20;
+}
+
+EXPORT int32_t ipasir_val(void* handle, int32_t lit) {
+    incremental_solver* wrapper = handle;
+    int variable_id = abs(lit);
+    if (variable_id > wrapper->s->num_variables) return 0;
+
+    int value = wrapper->s->values[lit];
+    if (value == 0) return 0;
+    return value > 0 ? lit : -lit;
+}
+
+EXPORT int ipasir_failed(void* handle, int32_t lit) {
+    incremental_solver* wrapper = handle;
+    int variable_id = abs(lit);
+    if (variable_id > wrapper->s->num_variables) return 0;
+    return wrapper->s->failed[variable_id];
+}
+
+EXPORT void ipasir_set_terminate(void* handle, void* data,
+        int (*terminate)(void* data)) {
+    incremental_solver* wrapper = handle;
+    wrapper->s->terminate = terminate;
+    wrapper->s->terminate_data = data;
+}
+
+EXPORT void ipasir_set_learn(void* handle, void* data, int max_length,
+        void (*learn)(void* data, int32_t* clause)) {
+    incremental_solver* wrapper = handle;
+    wrapper->s->learn_callback = learn;
+    wrapper->s->learn_data = data;
+    wrapper->s->learn_max_length = max_length;
+}
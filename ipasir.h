@@ -0,0 +1,51 @@
+#ifndef IPASIR_H
+#define IPASIR_H
+
+#include <stdint.h>
+
+// THE STANDARD INTERFACE OF INCREMENTAL SAT SOLVERS (IPASIR).
+// CLAUSES ARE ADDED A LITERAL AT A TIME, 0 ENDS THE CLAUSE. ASSUMPTIONS ONLY
+// HOLD FOR THE NEXT ipasir_solve(), EVERYTHING ELSE (CLAUSES, LEARNED
+// CLAUSES, ACTIVITIES AND SAVED PHASES) IS KEPT FROM ONE CALL TO THE NEXT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// NAME AND VERSION OF THE SOLVER
+const char* ipasir_signature(void);
+
+// A NEW SOLVER WITH AN EMPTY FORMULA, ipasir_release() FREES IT
+void* ipasir_init(void);
+void ipasir_release(void* solver);
+
+// ADD A LITERAL TO THE CLAUSE BEING BUILT, 0 ADDS THE CLAUSE
+void ipasir_add(void* solver, int32_t lit_or_zero);
+
+// ASSUME lit FOR THE NEXT ipasir_solve() ONLY
+void ipasir_assume(void* solver, int32_t lit);
+
+// RETURNS 10 FOR SAT, 20 FOR UNSAT (UNDER THE ASSUMPTIONS) AND 0 IF THE
+// SEARCH WAS INTERRUPTED BY THE TERMINATE CALLBACK
+int ipasir_solve(void* solver);
+
+// AFTER SAT: lit IF lit IS TRUE, -lit IF IT IS FALSE, 0 IF IT DOESN'T MATTER
+int32_t ipasir_val(void* solver, int32_t lit);
+
+// AFTER UNSAT: 1 IF THE ASSUMPTION lit WAS NEEDED TO PROVE IT, 0 IF NOT
+int ipasir_failed(void* solver, int32_t lit);
+
+// terminate(data) IS CALLED DURING THE SEARCH, A NON-ZERO RESULT STOPS IT
+void ipasir_set_terminate(void* solver, void* data,
+        int (*terminate)(void* data));
+
+// learn(data, clause) GETS EVERY LEARNED CLAUSE OF AT MOST max_length
+// LITERALS, 0 TERMINATED. THE CLAUSE IS ONLY VALID DURING THE CALL
+void ipasir_set_learn(void* solver, void* data, int max_length,
+        void (*learn)(void* data, int32_t* clause));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
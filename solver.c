@@ -0,0 +1,4280 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "solver.h"
+
+// This function may be used for debugging purposes
+void print_clause(solver* s, clause* clause) {
+    for (int i = 0; i < clause->size; i++) {
+        printf("|v%d:a%d:p%d@%d ",
+                clause->literals[i],
+                s->values[clause->literals[i]],
+                s->antecedents[abs(clause->literals[i])],
+                s->levels[abs(clause->literals[i])]);
+    }
+    printf("\n");
+}
+
+
+// zt_array - zero terminated array
+// (MUST BE ZERO TERMINATED OR ELSE SEGMENTATION FAULT)
+// the function determines position of zero in array -> array's size
+int index_of_zero(int* zt_array) {
+    int index;
+    for (index = 0; zt_array[index] != 0; index++);
+    return index;
+}
+
+// A SOLVER WITH NOTHING IN IT YET, PARSING FILLS IN THE FORMULA
+solver* new_solver(void) {
+    solver* s = (calloc(1, sizeof(solver)));
+    set_defaults(s);
+    return s;
+}
+
+// THE STATE OF A NEW SOLVER, ON TOP OF ALL ZEROS
+void set_defaults(solver* s) {
+    s->next_reduce = REDUCE_FIRST;
+    s->reduce_interval = REDUCE_FIRST;
+    s->clause_activity_bump = 1.0;
+    s->activity_bump = 1.0;
+    s->vsids_decay = VSIDS_DECAY;
+    s->restart_policy = RESTART_GLUCOSE;
+    s->next_inprocess = INPROCESS_FIRST;
+    s->inprocess_interval = INPROCESS_FIRST;
+    s->next_walk = WALK_FIRST;
+    s->walk_interval = WALK_FIRST;
+    s->start_time = seconds_now();
+    s->last_inprocess_time = s->start_time;
+}
+
+// FORGET THE FORMULA AND EVERYTHING LEARNED ABOUT IT, SO THAT THE NEXT ONE
+// CAN BE PARSED INTO THE SAME SOLVER. THE OPTIONS AND CALLBACKS STAY, AND SO
+// DOES THE MEMORY: THE ARENA, THE VARIABLE ARRAYS AND THE WATCH LISTS ARE
+// ONLY EMPTIED, SO A SMALLER FORMULA DOESN'T ALLOCATE ANYTHING
+void reset_solver(solver* s) {
+    close_proof(s);
+    free_xors(s);
+    free(s->eliminated);
+    free(s->export_buffer);
+    free(s->import_positions);
+    free(s->import_buffer);
+
+    solver kept = *s;
+    memset(s, 0, sizeof(solver));
+    set_defaults(s);
+
+    s->restart_policy = kept.restart_policy;
+    s->inprocessing = kept.inprocessing;
+    s->walking = kept.walking;
+    s->xor_recovery = kept.xor_recovery;
+    s->vsids_decay = kept.vsids_decay;
+    s->initial_phase = kept.initial_phase;
+    s->random_state = kept.random_state;
+    s->terminate = kept.terminate;
+    s->terminate_data = kept.terminate_data;
+    s->learn_callback = kept.learn_callback;
+    s->learn_data = kept.learn_data;
+    s->learn_max_length = kept.learn_max_length;
+    s->progress_interval = kept.progress_interval;
+    s->json_output = kept.json_output;
+
+    s->arena = kept.arena;
+    s->arena_capacity = kept.arena_capacity;
+    s->learned_refs = kept.learned_refs;
+    s->learned_capacity = kept.learned_capacity;
+    s->elimination_stack.clause_refs = kept.elimination_stack.clause_refs;
+    s->elimination_stack.capacity = kept.elimination_stack.capacity;
+    s->level_starts = kept.level_starts;
+    s->level_stamps = kept.level_stamps;
+    s->level_capacity = kept.level_capacity;
+    s->current_stamp = kept.current_stamp;
+    if (kept.values == NULL) return;
+
+    // add_variables() INITIALIZES THE REST OF THE VARIABLE STATE
+    int capacity = kept.variable_capacity;
+    s->variable_capacity = capacity;
+    s->values = kept.values;
+    memset(s->values - capacity, 0, 2 * capacity + 1);
+    s->levels = kept.levels;
+    s->antecedents = kept.antecedents;
+    s->activities = kept.activities;
+    s->saved_phases = kept.saved_phases;
+    s->watches = kept.watches;
+    s->binary_watches = kept.binary_watches;
+    for (int i = 0; i < 2 * (capacity + 1); i++) {
+        s->watches[i].size = 0;
+        s->binary_watches[i].size = 0;
+    }
+    s->trail = kept.trail;
+    s->heap = kept.heap;
+    s->heap_positions = kept.heap_positions;
+    s->seen = kept.seen;
+    memset(s->seen, 0, capacity + 1);
+    s->failed = kept.failed;
+    memset(s->failed, 0, capacity + 1);
+    s->learned_literals = kept.learned_literals;
+    s->analyze_stack = kept.analyze_stack;
+    s->analyze_to_clear = kept.analyze_to_clear;
+}
+
+// ALLOCATE THE SEARCH STATE FOR THE (PARSED AND PREPROCESSED) FORMULA,
+// FILL THE HEAP AND ATTACH THE WATCHES
+void init_search(solver* s) {
+    int num_variables = s->num_variables;
+    s->num_variables = 0;
+    add_variables(s, num_variables);
+
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* current = CLAUSE(ref);
+        if (current->deleted) continue;
+
+        // IF THE CLAUSE WAS UNIT, DON'T WATCH ANYTHING,
+        // IT IS ASSIGNED ON LEVEL 0 BY decide()
+        // OTHERWISE ATTACH CLAUSE TO LITERAL'S APPR WATCHED LIST
+        if (current->size > 1) attach_clause(s, ref);
+    }
+    if (s->num_xors > 0) start_gauss(s);
+}
+
+// MAKE ROOM FOR THE VARIABLES UP TO max_variable. THE NEW ONES ARE
+// UNASSIGNED AND GO TO THE HEAP. THE ARRAYS GROW BY DOUBLING, SO THAT
+// ADDING VARIABLES A FEW AT A TIME (AS INCREMENTAL USERS DO) STAYS CHEAP
+void add_variables(solver* s, int max_variable) {
+    int old_count = s->num_variables;
+    if (max_variable <= old_count) return;
+
+    if (max_variable > s->variable_capacity) {
+        int old_capacity = s->variable_capacity;
+        int old_entries = s->levels == NULL ? 0 : old_capacity + 1;
+        int capacity = 2 * old_capacity;
+        if (capacity < max_variable) capacity = max_variable;
+        s->variable_capacity = capacity;
+
+        // values IS CENTERED ON LITERAL 0, SO IT IS MOVED, NOT REALLOCATED
+        signed char* values =
+            (signed char*)(calloc(2 * capacity + 1, 1)) + capacity;
+        if (s->values != NULL) {
+            memcpy(values - old_count, s->values - old_count,
+                    2 * old_count + 1);
+            free(s->values - old_capacity);
+        }
+        s->values = values;
+        s->levels = (realloc(s->levels, sizeof(int) * (capacity + 1)));
+        s->antecedents = (realloc(s->antecedents,
+                    sizeof(int) * (capacity + 1)));
+        s->activities = (realloc(s->activities,
+                    sizeof(double) * (capacity + 1)));
+        s->saved_phases = (realloc(s->saved_phases, capacity + 1));
+        s->watches = (realloc(s->watches,
+                    sizeof(watcher_list) * 2 * (capacity + 1)));
+        memset(s->watches + 2 * old_entries, 0,
+                sizeof(watcher_list) * 2 * (capacity + 1 - old_entries));
+        s->binary_watches = (realloc(s->binary_watches,
+                    sizeof(watch_list) * 2 * (capacity + 1)));
+        memset(s->binary_watches + 2 * old_entries, 0,
+                sizeof(watch_list) * 2 * (capacity + 1 - old_entries));
+        s->trail = (realloc(s->trail, sizeof(int) * capacity));
+        s->heap = (realloc(s->heap, sizeof(int) * capacity));
+        s->heap_positions = (realloc(s->heap_positions,
+                    sizeof(int) * (capacity + 1)));
+        s->seen = (realloc(s->seen, capacity + 1));
+        memset(s->seen + old_entries, 0, capacity + 1 - old_entries);
+        s->failed = (realloc(s->failed, capacity + 1));
+        memset(s->failed + old_entries, 0, capacity + 1 - old_entries);
+        // ONE MORE FOR THE 0 THE LEARN CALLBACK GETS AFTER THE CLAUSE
+        s->learned_literals = (realloc(s->learned_literals,
+                    sizeof(int) * (capacity + 1)));
+        s->analyze_stack = (realloc(s->analyze_stack,
+                    sizeof(int) * capacity));
+        s->analyze_to_clear = (realloc(s->analyze_to_clear,
+                    sizeof(int) * capacity));
+    }
+
+    // INITIALIZE THE NEW LITERALS TO DEFAULT. A DIVERSIFIED SOLVER STARTS
+    // WITH RANDOM PHASES OR SMALL RANDOM ACTIVITIES INSTEAD OF ZEROS
+    for (int i = old_count == 0 ? 0 : old_count + 1; i <= max_variable; i++) {
+        s->levels[i] = -1;
+        s->antecedents[i] = -1;
+        s->activities[i] = 0;
+        s->saved_phases[i] = s->initial_phase;
+        if (s->random_state != 0) {
+            s->activities[i] = next_random(s) / 4294967296.0;
+            if (s->initial_phase == PHASE_RANDOM) {
+                s->saved_phases[i] = next_random(s) & 1;
+            }
+        }
+        s->heap_positions[i] = -1;
+    }
+    s->num_variables = max_variable;
+
+    // THE HEAP STARTS ORDERED BY ACTIVITY (BY ID IF ALL ARE EQUAL).
+    // ELIMINATED VARIABLES ARE NOT PART OF THE SEARCH
+    for (int i = old_count + 1; i <= max_variable; i++) {
+        if (s->eliminated == NULL || !s->eliminated[i]) {
+            s->unassigned_count++;
+            heap_insert(s, i);
+        }
+    }
+    reserve_levels(s);
+}
+
+// MAKE SURE level_starts AND level_stamps HAVE AN ENTRY FOR EVERY POSSIBLE
+// DECISION LEVEL: ONE PER VARIABLE, PLUS AN EMPTY ONE FOR EVERY ASSUMPTION
+// THAT WAS ALREADY TRUE, PLUS LEVEL 0
+void reserve_levels(solver* s) {
+    int needed = s->num_variables + s->assumption_count + 1;
+    if (needed <= s->level_capacity) return;
+
+    s->level_starts = (realloc(s->level_starts, sizeof(int) * needed));
+    s->level_stamps = (realloc(s->level_stamps, sizeof(int) * needed));
+    memset(s->level_stamps + s->level_capacity, 0,
+            sizeof(int) * (needed - s->level_capacity));
+    s->level_capacity = needed;
+}
+
+// UNDO EVERY DECISION A PREVIOUS SEARCH LEFT ON THE TRAIL, LEVEL 0 IS KEPT.
+// IF THERE ARE NONE, NOTHING IS TOUCHED, SO THAT LEVEL 0 LITERALS STILL
+// WAITING TO BE PROPAGATED ARE NOT LOST
+void backtrack_to_root(solver* s) {
+    int root_end = 0;
+    while (root_end < s->trail_size &&
+            s->levels[abs(s->trail[root_end])] == 0) {
+        root_end++;
+    }
+    if (root_end < s->trail_size) {
+        s->level_starts[1] = root_end;
+        backtrack(s, 0);
+    }
+}
+
+// ADD A CLAUSE BETWEEN TWO SEARCHES. IT IS SIMPLIFIED BY LEVEL 0: FALSE
+// LITERALS AND DUPLICATES ARE DROPPED, A SATISFIED OR TAUTOLOGICAL CLAUSE IS
+// NOT ADDED AT ALL AND THE LITERAL OF A UNIT ONE IS ASSIGNED. ITS VARIABLES
+// MUST ALREADY EXIST (SEE add_variables()).
+// RETURNS 0 IF THE FORMULA IS NOW UNSAT
+int add_clause(solver* s, const int* literals, int size) {
+    backtrack_to_root(s);
+    if (s->inconsistent) return 0;
+
+    // seen MARKS THE SIGNS ALREADY IN THE CLAUSE: BIT 1 POSITIVE, BIT 2
+    // NEGATIVE. THE SIMPLIFIED CLAUSE IS BUILT IN learned_literals
+    int* kept = s->learned_literals;
+    int kept_size = 0;
+    int satisfied = 0;
+    for (int i = 0; i < size; i++) {
+        int literal = literals[i];
+        int variable_id = abs(literal);
+        char sign = literal > 0 ? 1 : 2;
+
+        if (s->values[literal] > 0) satisfied = 1;
+        else if (s->values[literal] < 0 || (s->seen[variable_id] & sign)) {
+            continue;
+        }
+        else if (s->seen[variable_id]) satisfied = 1;
+        else {
+            s->seen[variable_id] = sign;
+            kept[kept_size] = literal;
+            kept_size++;
+        }
+    }
+    for (int i = 0; i < kept_size; i++) s->seen[abs(kept[i])] = 0;
+
+    if (satisfied) return 1;
+    if (kept_size == 0) {
+        s->inconsistent = 1;
+        return 0;
+    }
+
+    s->num_clauses++;
+    int clause_ref = allocate_clause(s, kept_size);
+    clause* added = CLAUSE(clause_ref);
+    memcpy(added->literals, kept, sizeof(int) * kept_size);
+
+    // A UNIT CLAUSE IS NOT WATCHED, ITS LITERAL IS PROPAGATED BY THE NEXT
+    // SEARCH
+    if (kept_size == 1) {
+        s->antecedents[abs(kept[0])] = clause_ref;
+        assign(s, abs(kept[0]), 0, kept[0] > 0);
+        return 1;
+    }
+    attach_clause(s, clause_ref);
+    return 1;
+}
+
+// FREE THE SOLVER AND EVERYTHING IT OWNS
+void free_solver(solver* s) {
+    close_proof(s);
+    free_xors(s);
+    if (s->watches != NULL) {
+        for (int i = 0; i < 2 * (s->variable_capacity + 1); i++) {
+            free(s->watches[i].watchers);
+            free(s->binary_watches[i].clause_refs);
+        }
+    }
+    free(s->watches);
+    free(s->binary_watches);
+    free(s->trail);
+    free(s->level_starts);
+    free(s->heap);
+    free(s->heap_positions);
+    free(s->seen);
+    free(s->failed);
+    free(s->learned_literals);
+    free(s->analyze_stack);
+    free(s->analyze_to_clear);
+    free(s->level_stamps);
+    free(s->learned_refs);
+    free(s->eliminated);
+    free(s->elimination_stack.clause_refs);
+    free(s->export_buffer);
+    free(s->import_positions);
+    free(s->import_buffer);
+    free(s->arena);
+    if (s->values != NULL) free(s->values - s->variable_capacity);
+    free(s->levels);
+    free(s->antecedents);
+    free(s->activities);
+    free(s->saved_phases);
+    free(s);
+}
+
+
+// PARSER
+// PLAIN FILES ARE MAPPED INTO MEMORY AND SCANNED IN PLACE, COMPRESSED ONES
+// (RECOGNIZED BY THEIR MAGIC BYTES) ARE PIPED THROUGH THE DECOMPRESSOR.
+// RETURNS THE NUMBER OF CLAUSES AND XORS KEPT (0 IS A FORMULA THAT ALWAYS
+// HOLDS), -1 ON ERROR
+int parse_cnf(solver* s, const char* cnf_filepath) {
+
+    int fd = open(cnf_filepath, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "PARSE ERROR: file not found: %s\n",
+                cnf_filepath);
+        return -1;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        fprintf(stderr, "PARSE ERROR: can't read file: %s\n", cnf_filepath);
+        close(fd);
+        return -1;
+    }
+
+    // NOTHING TO MAP, AN EMPTY FILE IS AN EMPTY FORMULA
+    parser_state state;
+    if (info.st_size == 0) {
+        close(fd);
+        start_parsing(s, &state, 0);
+        return finish_parsing(s, &state, 1);
+    }
+
+    unsigned char magic[6] = {0};
+    ssize_t magic_size = read(fd, magic, sizeof(magic));
+
+    const char* decompressor = NULL;
+    if (magic_size >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        decompressor = "gzip";
+    }
+    else if (magic_size >= 6 && !memcmp(magic, "\xfd" "7zXZ\0", 6)) {
+        decompressor = "xz";
+    }
+    else if (magic_size >= 3 && !memcmp(magic, "BZh", 3)) {
+        decompressor = "bzip2";
+    }
+
+    if (decompressor != NULL) {
+        close(fd);
+        return parse_compressed(s, cnf_filepath, decompressor,
+                (long long)info.st_size * COMPRESSION_RATIO);
+    }
+
+    char* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "PARSE ERROR: can't map file: %s\n", cnf_filepath);
+        return -1;
+    }
+    posix_madvise(data, info.st_size, POSIX_MADV_SEQUENTIAL);
+
+    start_parsing(s, &state, info.st_size);
+    int ok = parse_dimacs(s, &state, data, data + info.st_size);
+    munmap(data, info.st_size);
+    return finish_parsing(s, &state, ok);
+}
+
+// RUN "decompressor -dc FILE" AND PARSE ITS OUTPUT AS IT COMES. THE
+// DECOMPRESSOR IS A SEPARATE PROCESS, SO IT WORKS WHILE WE TOKENIZE.
+// ONLY COMPLETE LINES ARE HANDED TO THE PARSER, THE REST OF A CHUNK IS
+// MOVED TO THE FRONT OF THE BUFFER AND COMPLETED BY THE NEXT READ
+int parse_compressed(solver* s, const char* cnf_filepath,
+        const char* decompressor, long long input_bytes) {
+
+    int pipe_fds[2];
+    if (pipe(pipe_fds) < 0) {
+        fprintf(stderr, "PARSE ERROR: can't create pipe\n");
+        return -1;
+    }
+
+    pid_t child = fork();
+    if (child < 0) {
+        fprintf(stderr, "PARSE ERROR: can't start %s\n", decompressor);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        return -1;
+    }
+    if (child == 0) {
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        execlp(decompressor, decompressor, "-dc", "--", cnf_filepath,
+                (char*)NULL);
+        _exit(127);
+    }
+    close(pipe_fds[1]);
+
+    parser_state state;
+    start_parsing(s, &state, input_bytes);
+
+    int capacity = STREAM_CHUNK;
+    char* buffer = (malloc(capacity));
+    int filled = 0;
+    int ok = 1;
+
+    while (ok && !state.done) {
+        // A SINGLE LINE LONGER THAN THE BUFFER, MAKE ROOM
+        if (filled == capacity) {
+            capacity *= 2;
+            buffer = (realloc(buffer, capacity));
+        }
+
+        ssize_t got = read(pipe_fds[0], buffer + filled, capacity - filled);
+        if (got < 0) {
+            ok = 0;
+            break;
+        }
+
+        // END OF STREAM, WHATEVER IS LEFT IS THE LAST LINE
+        if (got == 0) {
+            ok = parse_dimacs(s, &state, buffer, buffer + filled);
+            break;
+        }
+        filled += got;
+
+        int line_end = filled;
+        while (line_end > 0 && buffer[line_end - 1] != '\n') line_end--;
+        if (line_end == 0) continue;
+
+        ok = parse_dimacs(s, &state, buffer, buffer + line_end);
+        memmove(buffer, buffer + line_end, filled - line_end);
+        filled -= line_end;
+    }
+
+    free(buffer);
+    close(pipe_fds[0]);
+
+    int status;
+    waitpid(child, &status, 0);
+    if (ok && !state.done &&
+            (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        fprintf(stderr, "PARSE ERROR: %s failed on %s\n",
+                decompressor, cnf_filepath);
+        ok = 0;
+    }
+    return finish_parsing(s, &state, ok);
+}
+
+// SCAN AN UNSIGNED DECIMAL NUMBER AT *pos, MOVING *pos PAST IT.
+// RETURNS -1 IF THERE IS NO NUMBER OR IT DOESN'T FIT INTO AN int
+int scan_number(const char** pos, const char* end) {
+    const char* p = *pos;
+    if (p == end || *p < '0' || *p > '9') return -1;
+
+    int value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        int digit = *p - '0';
+        if (value > (INT_MAX - digit) / 10) return -1;
+        value = value * 10 + digit;
+        p++;
+    }
+    *pos = p;
+    return value;
+}
+
+// END OF A PARSED CLAUSE, CLEAR THE MARKS AND FILL IN THE HEADER.
+// THE CLAUSE IS DROPPED IF IT IS A TAUTOLOGY (OR EMPTY).
+// RETURNS 1 IF THE CLAUSE WAS KEPT
+int finish_parsed_clause(solver* s, int clause_start, char* marks) {
+    int size = s->arena_size - clause_start - HEADER_WORDS;
+    int tautology = 0;
+    for (int i = clause_start + HEADER_WORDS; i < s->arena_size; i++) {
+        int variable_id = abs(s->arena[i]);
+        if (marks[variable_id] == 3) tautology = 1;
+        marks[variable_id] = 0;
+    }
+
+    if (tautology || size == 0) {
+        s->arena_size = clause_start;
+        return 0;
+    }
+    memset(CLAUSE(clause_start), 0, sizeof(clause));
+    CLAUSE(clause_start)->size = size;
+    return 1;
+}
+
+// END OF A PARSED "x" LINE: A VARIABLE THAT IS IN IT TWICE CANCELS OUT, A
+// NEGATIVE LITERAL FLIPS THE PARITY. THE XOR IS DROPPED IF NO VARIABLE IS
+// LEFT AND IT HOLDS ANYWAY. RETURNS 1 IF THE XOR WAS KEPT
+int finish_parsed_xor(solver* s, parser_state* state) {
+    int* literals = state->xor_literals.clause_refs;
+    int parity = 1;
+    int size = 0;
+
+    // BIT 4 OF THE MARKS IS SET FOR THE VARIABLES THAT ARE IN IT AN ODD
+    // NUMBER OF TIMES
+    for (int i = 0; i < state->xor_literals.size; i++) {
+        if (literals[i] < 0) parity ^= 1;
+    }
+    for (int i = 0; i < state->xor_literals.size; i++) {
+        int variable_id = abs(literals[i]);
+        if (state->marks[variable_id] & 4) {
+            literals[size] = variable_id;
+            size++;
+        }
+        state->marks[variable_id] = 0;
+    }
+    state->xor_literals.size = 0;
+    state->in_xor = 0;
+
+    if (size == 0 && parity == 0) return 0;
+    add_xor(s, literals, size, parity);
+    return 1;
+}
+
+void start_parsing(solver* s, parser_state* state, long long input_bytes) {
+    s->num_variables = 0;
+    state->marks = NULL;
+    state->marks_size = 0;
+    state->clause_start = -1;
+    state->clause_count = 0;
+    state->done = 0;
+    state->input_bytes = input_bytes;
+    state->in_xor = 0;
+    memset(&state->xor_literals, 0, sizeof(watch_list));
+}
+
+// CLOSE THE LAST CLAUSE (A MISSING 0 AFTER IT IS TOLERATED) AND CLEAN UP.
+// RETURNS THE NUMBER OF CLAUSES AND XORS KEPT, -1 IF PARSING FAILED
+int finish_parsing(solver* s, parser_state* state, int ok) {
+    if (ok && state->clause_start >= 0) {
+        state->clause_count +=
+            finish_parsed_clause(s, state->clause_start, state->marks);
+    }
+    if (ok && state->in_xor) {
+        state->clause_count += finish_parsed_xor(s, state);
+    }
+    free(state->marks);
+    free(state->xor_literals.clause_refs);
+    return ok ? state->clause_count : -1;
+}
+
+// PARSE DIMACS CNF FROM THE BUFFER, WRITING LITERALS STRAIGHT INTO THE ARENA.
+// THE BUFFER MAY END BETWEEN ANY TWO LINES, A CLAUSE CAN BE CONTINUED BY
+// THE NEXT CALL. DUPLICATE LITERALS ARE DROPPED, SO ARE TAUTOLOGICAL CLAUSES.
+// A LINE STARTING WITH x IS AN XOR CONSTRAINT (AS IN CRYPTOMINISAT): THE
+// XOR OF ITS LITERALS IS TRUE. RETURNS 0 ON ERROR
+int parse_dimacs(solver* s, parser_state* state,
+        const char* pos, const char* end) {
+
+    while (pos < end && !state->done) {
+        char c = *pos;
+
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            pos++;
+            continue;
+        }
+
+        // COMMENT, SKIP THE LINE
+        if (c == 'c') {
+            while (pos < end && *pos != '\n') pos++;
+            continue;
+        }
+
+        // HEADER, USE IT TO PREALLOCATE
+        if (c == 'p') {
+            pos++;
+            while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+            if (end - pos < 3 || strncmp(pos, "cnf", 3)) {
+                fprintf(stderr, "PARSE ERROR: bad header!\n");
+                return 0;
+            }
+            pos += 3;
+            while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+            int header_variables = scan_number(&pos, end);
+            while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+            int header_clauses = scan_number(&pos, end);
+            if (header_variables < 0 || header_clauses < 0) {
+                fprintf(stderr, "PARSE ERROR: bad header!\n");
+                return 0;
+            }
+
+            if (header_variables > s->num_variables) {
+                s->num_variables = header_variables;
+            }
+            if (header_variables >= state->marks_size) {
+                grow_marks(state, header_variables);
+            }
+
+            // ONLY A HINT: A LITERAL TAKES AT LEAST 2 BYTES, SO THE INPUT
+            // CAN'T NEED MORE WORDS THAN HALF ITS SIZE. IF EVEN THAT CAN'T
+            // BE HAD THE ARENA JUST GROWS AS THE CLAUSES COME
+            long long words = (long long)header_clauses * CLAUSE_WORDS(3);
+            if (words > state->input_bytes / 2) {
+                words = state->input_bytes / 2;
+            }
+            reserve_arena(s, words);
+            continue;
+        }
+
+        // SOME BENCHMARK SETS END WITH "%"
+        if (c == '%') {
+            state->done = 1;
+            break;
+        }
+
+        // XOR OF THE LITERALS UP TO THE NEXT 0, THE FIRST MAY FOLLOW THE x
+        // DIRECTLY
+        if (c == 'x' && state->clause_start < 0 && !state->in_xor) {
+            state->in_xor = 1;
+            pos++;
+            continue;
+        }
+
+        // LITERAL
+        int negative = c == '-';
+        if (negative) pos++;
+        int number = scan_number(&pos, end);
+        if (number < 0 || (pos < end && *pos != ' ' && *pos != '\t' &&
+                    *pos != '\n' && *pos != '\r')) {
+            fprintf(stderr, "PARSE ERROR: unexpected char!\n");
+            return 0;
+        }
+
+        if (state->in_xor) {
+            if (number == 0) {
+                state->clause_count += finish_parsed_xor(s, state);
+                continue;
+            }
+            if (number > s->num_variables) s->num_variables = number;
+            if (number >= state->marks_size) grow_marks(state, 2 * number);
+            state->marks[number] ^= 4;
+            push_int(&state->xor_literals, negative ? -number : number);
+            continue;
+        }
+
+        if (state->clause_start < 0) {
+            if (!reserve_arena(s, HEADER_WORDS)) {
+                fprintf(stderr, "PARSE ERROR: formula too large!\n");
+                return 0;
+            }
+            state->clause_start = s->arena_size;
+            s->arena_size += HEADER_WORDS;
+        }
+
+        if (number == 0) {
+            state->clause_count +=
+                finish_parsed_clause(s, state->clause_start, state->marks);
+            state->clause_start = -1;
+            continue;
+        }
+
+        if (number > s->num_variables) s->num_variables = number;
+        if (number >= state->marks_size) grow_marks(state, 2 * number);
+
+        // SKIP DUPLICATES, BUT KEEP THE OPPOSITE SIGN TO NOTICE TAUTOLOGIES
+        int bit = negative ? 2 : 1;
+        if (state->marks[number] & bit) continue;
+        state->marks[number] |= bit;
+
+        if (!reserve_arena(s, 1)) {
+            fprintf(stderr, "PARSE ERROR: formula too large!\n");
+            return 0;
+        }
+        s->arena[s->arena_size] = negative ? -number : number;
+        s->arena_size++;
+    }
+
+    return 1;
+}
+
+// MAKE THE MARKS ARRAY BIG ENOUGH FOR VARIABLES UP TO max_variable
+void grow_marks(parser_state* state, int max_variable) {
+    int old_size = state->marks_size;
+    state->marks_size = max_variable + 1;
+    state->marks = (realloc(state->marks, state->marks_size));
+    memset(state->marks + old_size, 0, state->marks_size - old_size);
+}
+
+// NAME OF THE SOLUTION FILE FOR THE INPUT FILE: THE EXTENSION OF THE INPUT
+// (AFTER DROPPING A COMPRESSION ONE, E.G. foo.cnf.xz) IS REPLACED WITH .sat
+char* solution_filename(const char* cnf_path) {
+    const char* compressed[] = {".gz", ".xz", ".bz2", NULL};
+
+    int length = strlen(cnf_path);
+    char* filename = (malloc(length + 5));
+    strcpy(filename, cnf_path);
+
+    for (int i = 0; compressed[i] != NULL; i++) {
+        int ext_length = strlen(compressed[i]);
+        if (length > ext_length &&
+                !strcmp(filename + length - ext_length, compressed[i])) {
+            length -= ext_length;
+            filename[length] = '\0';
+            break;
+        }
+    }
+
+    // ONLY A DOT IN THE LAST PATH COMPONENT STARTS AN EXTENSION
+    char* dot = strrchr(filename, '.');
+    char* slash = strrchr(filename, '/');
+    if (dot != NULL && (slash == NULL || dot > slash)) *dot = '\0';
+    strcat(filename, ".sat");
+    return filename;
+}
+
+// WRITE THE ANSWER, AND FOR SAT THE MODEL, TO THE SOLUTION FILE.
+// RETURNS 0 IF IT CAN'T BE WRITTEN
+int write_solution(solver* s, const char* solution_path, int sat) {
+    FILE* output_sat = fopen(solution_path, "w");
+    if (output_sat == NULL) {
+        fprintf(stderr, "can't write solution file: %s\n", solution_path);
+        return 0;
+    }
+
+    if (!sat) fprintf(output_sat, "s UNSATISFIABLE\n");
+    else {
+        fprintf(output_sat, "s SATISFIABLE\nv ");
+        for (int i = 1; i <= s->num_variables; i++) {
+            int sign = s->values[i] < 0 ? -1 : 1;
+            fprintf(output_sat, "%d ", i * sign);
+        }
+        fprintf(output_sat, "0\n");
+    }
+    fclose(output_sat);
+    return 1;
+}
+
+// THE SEARCH LOOP: PROPAGATE, ON CONFLICT LEARN AND BACKJUMP,
+// OTHERWISE BRANCH ON THE VARIABLE WITH THE LARGEST ACTIVITY.
+// THE ASSUMPTIONS ARE THE FIRST DECISIONS. CAN BE CALLED AGAIN (WITH OTHER
+// ASSUMPTIONS), WHAT WAS LEARNED IS KEPT.
+// RETURNS 1 FOR SAT, 0 FOR UNSAT (UNDER THE ASSUMPTIONS), OR SEARCH_STOPPED
+// IF ANOTHER SOLVER OF THE PORTFOLIO ANSWERED FIRST
+int decide(solver* s) {
+
+    int decision_level = 0;
+    if (s->inconsistent) return 0;
+
+    // A PREVIOUS CALL MAY HAVE LEFT DECISIONS ON THE TRAIL
+    reserve_levels(s);
+    backtrack_to_root(s);
+    if (s->assumption_count > 0) memset(s->failed, 0, s->num_variables + 1);
+
+    if (!assign_units(s)) {
+        s->inconsistent = 1;
+        return 0;
+    }
+
+    while (1) {
+        if (s->shared != NULL &&
+                __atomic_load_n(&s->shared->stop, __ATOMIC_RELAXED)) {
+            return SEARCH_STOPPED;
+        }
+
+        // ONLY A SAMPLE OF THE CALLS IS TIMED, READING THE CLOCK EVERY TIME
+        // WOULD SHOW IN THE SEARCH SPEED
+        int timed = (++s->num_timed & (TIMING_SAMPLE - 1)) == 0;
+        double propagate_start = timed ? seconds_now() : 0;
+        int conflict = propagate(s, decision_level);
+        if (timed) {
+            s->propagate_seconds +=
+                TIMING_SAMPLE * (seconds_now() - propagate_start);
+        }
+
+        // THE XORS ONLY COME WHEN THE CLAUSES HAVE NOTHING LEFT, WHAT THEY
+        // IMPLY GOES THROUGH THE CLAUSES FIRST
+        if (conflict == NO_CONFLICT && s->num_matrices > 0) {
+            int trail_size = s->trail_size;
+            conflict = gauss_propagate(s, decision_level);
+            if (conflict == NO_CONFLICT && s->trail_size > trail_size) {
+                continue;
+            }
+        }
+
+        if (conflict != NO_CONFLICT) {
+            s->num_conflicts++;
+
+            // SINCE IT IS LEVEL 0 NO CONFLICT IS ALLOWED HERE,
+            // WHICH MEANS UNSAT PROBLEM, WHATEVER IS ADDED OR ASSUMED LATER
+            if (decision_level == 0) {
+                s->inconsistent = 1;
+                return 0;
+            }
+
+            // LEARN FROM THE CONFLICT, JUMP BACK AND ASSERT THE LEARNED
+            // CLAUSE THERE
+            timed = (s->num_conflicts & (TIMING_SAMPLE - 1)) == 0;
+            double analyze_start = timed ? seconds_now() : 0;
+            decision_level = learn(s, conflict, decision_level);
+            if (timed) {
+                s->analyze_seconds +=
+                    TIMING_SAMPLE * (seconds_now() - analyze_start);
+            }
+            if (s->num_conflicts >= s->next_progress_check) check_progress(s);
+
+            // KEEP THE LEARNED CLAUSE DATABASE AT A BOUNDED SIZE
+            if (s->num_learned >= s->next_reduce) {
+                reduce_learned(s);
+                s->reduce_interval += REDUCE_INCREMENT;
+                s->next_reduce = s->num_learned + s->reduce_interval;
+            }
+
+            // THE LIBRARY USER MAY WANT TO GIVE UP
+            if (s->terminate != NULL && s->terminate(s->terminate_data)) {
+                return SEARCH_STOPPED;
+            }
+            continue;
+        }
+
+        // ASSUMPTIONS GO FIRST, ONE DECISION LEVEL EACH (EMPTY IF THE
+        // ASSUMPTION IS ALREADY TRUE). ONE THAT IS FALSE CAN'T BE SATISFIED
+        if (decision_level < s->assumption_count) {
+            int literal = s->assumptions[decision_level];
+            if (s->values[literal] < 0) {
+                analyze_final(s, literal);
+                return 0;
+            }
+
+            decision_level++;
+            s->level_starts[decision_level] = s->trail_size;
+            if (s->values[literal] == 0) {
+                assign(s, abs(literal), decision_level, literal > 0);
+            }
+            continue;
+        }
+
+        // bottom of the problem is reached
+        if (s->unassigned_count == 0) return 1;
+
+        // START OVER FROM LEVEL 0, KEEPING LEARNED CLAUSES, ACTIVITIES
+        // AND SAVED PHASES.
+        // INPROCESSING AND LOCAL SEARCH ALSO NEED LEVEL 0
+        if (decision_level > 0 &&
+                (restart_due(s) || inprocess_due(s) || walk_due(s))) {
+            s->num_restarts++;
+            backtrack(s, 0);
+            decision_level = 0;
+
+            if (inprocess_due(s) && !inprocess(s)) {
+                s->inconsistent = 1;
+                return 0;
+            }
+
+            // A MODEL FOUND BY THE LOCAL SEARCH IS ALREADY ASSIGNED
+            if (walk_due(s)) {
+                long long flips = WALK_EFFORT *
+                    (s->num_propagations - s->last_walk_propagations);
+                if (walk(s, flips > WALK_MIN_FLIPS ? flips : WALK_MIN_FLIPS)) {
+                    return 1;
+                }
+            }
+
+            // CLAUSES FROM OTHER SOLVERS ARE ONLY TAKEN ON LEVEL 0
+            if (s->shared != NULL && !import_clauses(s)) return 0;
+            continue;
+        }
+
+        // FIND VARIABLE WITH LARGEST VSIDS TO ASSIGN,
+        // ASSIGNED VARIABLES ARE ONLY DROPPED FROM THE HEAP WHEN THEY COME UP
+        int variable_id = heap_pop(s);
+        while (s->values[variable_id] != 0) {
+            variable_id = heap_pop(s);
+        }
+
+        if (s->values[variable_id] != 0) {
+            fprintf(stderr,
+                    "FAILED ASSERTION! ASSIGNING ALREADY ASSIGNED VARIABLE!\n");
+            exit(1);
+        }
+
+        // OPEN A NEW DECISION LEVEL AND TRY THE VALUE THE VARIABLE HAD LAST
+        // TIME (FALSE AT FIRST), IF THAT IS WRONG THE CONFLICT ANALYSIS WILL
+        // FLIP IT
+        s->num_branching++;
+        decision_level++;
+        s->level_starts[decision_level] = s->trail_size;
+        assign(s, variable_id, decision_level,
+                s->saved_phases[variable_id]);
+    }
+}
+
+// FIND THE ASSUMPTIONS THAT MADE THE ASSUMED literal FALSE BY FOLLOWING
+// THE ANTECEDENTS BACK FROM IT. ONLY ASSUMPTIONS HAVE BEEN DECIDED YET, SO
+// EVERY DECISION REACHED IS ONE. THEY ARE MARKED IN failed, SO IS literal
+void analyze_final(solver* s, int literal) {
+    s->failed[abs(literal)] = 1;
+    if (s->levels[abs(literal)] == 0) return;
+
+    s->seen[abs(literal)] = 1;
+    for (int i = s->trail_size - 1; i >= s->level_starts[1]; i--) {
+        int variable_id = abs(s->trail[i]);
+        if (!s->seen[variable_id]) continue;
+        s->seen[variable_id] = 0;
+
+        int antecedent = s->antecedents[variable_id];
+        if (antecedent == -1) {
+            s->failed[variable_id] = 1;
+            continue;
+        }
+        int reason_size;
+        int* reason = reason_literals(s, antecedent, &reason_size);
+        for (int j = 0; j < reason_size; j++) {
+            int other = abs(reason[j]);
+            if (other != variable_id &&
+                    s->levels[other] > 0) {
+                s->seen[other] = 1;
+            }
+        }
+    }
+}
+
+// ON DECISION LEVEL 0 ASSIGN LITERALS FROM ONE-SIZED CLAUSES,
+// IF ANY OF THEM IS ALREADY FALSE, THE PROBLEM IS UNSAT (RETURNS 0)
+int assign_units(solver* s) {
+    s->level_starts[0] = 0;
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        if (CLAUSE(ref)->size != 1 || CLAUSE(ref)->deleted) continue;
+
+        int to_assign = CLAUSE(ref)->literals[0];
+        int assignID = abs(to_assign);
+        int assignment = to_assign > 0 ? 1 : 0;
+
+        if (s->values[to_assign] == 0) {
+            s->antecedents[assignID] = ref;
+            assign(s, assignID, 0, assignment);
+        }
+        else if (s->values[to_assign] < 0) return 0;
+    }
+    return 1;
+}
+
+// RECORD THE ASSIGNMENT AND PUT IT ON THE TRAIL.
+// NOTHING IS PROPAGATED HERE, THAT IS DONE LATER BY propagate()
+void assign(solver* s, int variable_id, int decision_level, int assignment) {
+
+    // ACTUALLY ASSIGN LITERAL
+    int literal = assignment ? variable_id : -variable_id;
+    s->values[literal] = 1;
+    s->values[-literal] = -1;
+    s->levels[variable_id] = decision_level;
+    s->unassigned_count--;
+
+    s->trail[s->trail_size] = literal;
+    s->trail_size++;
+}
+
+// VISIT THE WATCHES OF EVERY LITERAL ON THE TRAIL THAT WAS NOT YET
+// PROPAGATED. IMPLIED LITERALS ARE APPENDED TO THE TRAIL BY replace_watched()
+// AND PICKED UP BY THE SAME LOOP, SO NO RECURSION IS INVOLVED.
+// BINARY CLAUSES ARE CHEAPER, SO ALL OF THEM ARE PROPAGATED BEFORE EACH
+// LITERAL'S LONGER CLAUSES ARE VISITED. A BINARY CONFLICT IS RETURNED AS
+// BINARY_CONFLICT WITH ITS LITERALS IN binary_conflict
+int propagate(solver* s, int decision_level) {
+
+    while (s->propagation_head < s->trail_size) {
+        while (s->binary_head < s->trail_size) {
+            int false_literal = -s->trail[s->binary_head];
+            s->binary_head++;
+
+            // EVERY ENTRY IS THE OTHER LITERAL OF A BINARY CLAUSE
+            watch_list* implied =
+                s->binary_watches + WATCH_INDEX(false_literal);
+            for (int i = 0; i < implied->size; i++) {
+                int literal = implied->clause_refs[i];
+                if (s->values[literal] > 0) continue;
+
+                if (s->values[literal] == 0) {
+                    s->antecedents[abs(literal)] =
+                        BINARY_ANTECEDENT(false_literal);
+                    assign(s, abs(literal), decision_level, literal > 0);
+                    continue;
+                }
+                s->binary_conflict[0] = literal;
+                s->binary_conflict[1] = false_literal;
+                return BINARY_CONFLICT;
+            }
+        }
+
+        // THE LITERAL THAT WAS JUST MADE FALSE
+        int false_literal = -s->trail[s->propagation_head];
+        s->propagation_head++;
+        s->num_propagations++;
+
+        // THE LIST OF CLAUSES IN WHICH THE NOW FALSE LITERAL IS WATCHED.
+        // CLAUSES, WHERE THERE WAS FOUND ANOTHER LITERAL TO WATCH, ARE REMOVED
+        // FROM THE LIST BY COMPACTING IT IN PLACE: read WALKS OVER ALL
+        // ENTRIES, write POINTS TO THE END OF THE ENTRIES THAT ARE KEPT
+        watcher_list* to_update = s->watches + WATCH_INDEX(false_literal);
+        watcher* watchers = to_update->watchers;
+        int read = 0;
+        int write = 0;
+
+        while (read < to_update->size) {
+            watcher current = watchers[read];
+            read++;
+
+            // A TRUE BLOCKER SATISFIES THE CLAUSE, NO NEED TO LOOK INTO IT
+            int result = VISIT_RESOLVED;
+            if (s->values[current.blocker] <= 0) {
+                // TRY FINDING IN EACH CLAUSE ANOTHER LITERAL TO WATCH
+                result = replace_watched(s, &current,
+                        false_literal, decision_level);
+
+                // IF JUST FOUND, THE CLAUSE IS NOW WATCHED ELSEWHERE, DROP IT
+                if (result == VISIT_NORMAL) continue;
+            }
+
+            // OTHERWISE THE CURRENT CLAUSE IS KEPT ON THE LIST
+            watchers[write] = current;
+            write++;
+
+            // IN CASE OF CONFLICT JUST STOP AND REPORT THE CLAUSE
+            // (BACKTRACKING DONE IN decide())
+            // THE UNVISITED TAIL IS KEPT AS WELL
+            if (result == VISIT_CONFLICT) {
+                while (read < to_update->size) {
+                    watchers[write] = watchers[read];
+                    read++;
+                    write++;
+                }
+                to_update->size = write;
+                return current.clause_ref;
+            }
+        }
+        to_update->size = write;
+    }
+
+    // SUCCESS!
+    return NO_CONFLICT;
+}
+
+// NECESSARY CLEAN-UP FOR BACKTRACKING IS DONE HERE
+// EVERYTHING ASSIGNED ABOVE decision_level IS AT THE END OF THE TRAIL,
+// SO BACKJUMPING ANY NUMBER OF LEVELS IS A SINGLE TRUNCATION
+void backtrack(solver* s, int decision_level) {
+
+    int new_size = s->level_starts[decision_level + 1];
+
+    // ERASE ASSIGNMENT, THE VARIABLE BECOMES A BRANCHING CANDIDATE AGAIN
+    for (int i = s->trail_size - 1; i >= new_size; i--) {
+        int literal = s->trail[i];
+        int variable_id = abs(literal);
+        heap_insert(s, variable_id);
+        s->saved_phases[variable_id] = literal > 0;
+        s->values[literal] = 0;
+        s->values[-literal] = 0;
+        s->levels[variable_id] = -1;
+        s->antecedents[variable_id] = -1;
+        s->unassigned_count++;
+    }
+
+    // DROP THE UNASSIGNED LITERALS TOGETHER WITH WHATEVER WAS STILL WAITING
+    // TO BE PROPAGATED
+    s->trail_size = new_size;
+    s->propagation_head = s->trail_size;
+    s->binary_head = s->trail_size;
+
+    // THE COPIES OF THE XOR MATRICES MADE ABOVE THE LEVEL ARE OUTDATED
+    for (int i = 0; i < s->num_matrices; i++) {
+        gauss* g = s->matrices + i;
+        while (g->count > 1 && g->levels[g->count - 1] > decision_level) {
+            g->count--;
+        }
+    }
+}
+
+// VISIT A CLAUSE WATCHING to_replace, WHICH WAS JUST MADE FALSE.
+// THE WATCHED LITERALS ARE literals[0] AND literals[1], to_replace IS MOVED
+// TO literals[1] FIRST. IF THE CLAUSE STAYS ON THE WATCH LIST, THE OTHER
+// WATCHED LITERAL BECOMES THE BLOCKER OF entry, SINCE IT IS TRUE NOW
+int replace_watched(solver* s, watcher* entry, int to_replace,
+        int decision_level) {
+
+    clause* current = CLAUSE(entry->clause_ref);
+    int* literals = current->literals;
+    if (literals[0] == to_replace) {
+        literals[0] = literals[1];
+        literals[1] = to_replace;
+    }
+
+    // aw FOR anotherWatched
+    // IF IT IS RESOLVING THIS CLAUSE THEN NO MORE WORK HERE
+    int aw = literals[0];
+    entry->blocker = aw;
+    if (s->values[aw] > 0) return VISIT_RESOLVED;
+
+    // LOOK FOR ANOTHER LITERAL TO WATCH: ANY THAT IS NOT FALSE
+    for (int i = 2; i < current->size; i++) {
+        int candidate = literals[i];
+        if (s->values[candidate] >= 0) {
+            literals[1] = candidate;
+            literals[i] = to_replace;
+            watch_clause(s, entry->clause_ref, candidate, aw);
+            return VISIT_NORMAL;
+        }
+    }
+
+    // OR THERE IN AN IMPLICATION, IN CASE OF SUCCESSFUL IMPLICATION
+    // RETURN VISIT_RESOLVED
+    // ELSE PROPAGATE THE CONFLICT
+
+    if (s->values[aw] == 0) {
+        // mark this clause as antecedent for this variable
+        s->antecedents[abs(aw)] = entry->clause_ref;
+
+        // THE IMPLIED LITERAL IS ONLY QUEUED, propagate() VISITS IT LATER
+        assign(s, abs(aw), decision_level, aw > 0);
+        return VISIT_RESOLVED;
+    }
+
+    // ANOTHER WATCH HAS ALSO ZEROING ASSIGNMENT, WHICH LEADS TO CONFLICT!
+    return VISIT_CONFLICT;
+}
+
+// LEARN A CLAUSE FROM THE CONFLICT, ADD IT TO THE DATABASE,
+// BACKJUMP AND ASSIGN ITS ONLY LITERAL FROM THE CONFLICT LEVEL.
+// RETURNS THE DECISION LEVEL THE SEARCH CONTINUES ON
+int learn(solver* s, int conflict, int decision_level) {
+
+    int* learned_literals = s->learned_literals;
+    int learned_size = first_uip(s, conflict, decision_level);
+    proof_add(s, learned_literals, learned_size);
+    decay_activities(s);
+    s->clause_activity_bump /= CLAUSE_DECAY;
+
+    // FIND OUT SECOND LATEST DECISION LEVEL IN A LEARNED CLAUSE TO BACKTRACK
+    // TO AND MOVE THAT LITERAL TO POSITION 1 (THE ASSERTED ONE IS AT 0).
+    // IF THE CLAUSE IS UNIT, RETURN TO LEVEL ZERO AND ASSIGN
+    int backjump_level = 0;
+    if (learned_size > 1) {
+        int latest = 1;
+        for (int i = 2; i < learned_size; i++) {
+            if (s->levels[abs(learned_literals[i])] >
+                    s->levels[abs(learned_literals[latest])]) {
+                latest = i;
+            }
+        }
+        int tmp = learned_literals[1];
+        learned_literals[1] = learned_literals[latest];
+        learned_literals[latest] = tmp;
+        backjump_level = s->levels[abs(learned_literals[1])];
+    }
+
+    // THE LEVELS ARE STILL ASSIGNED, SO LBD IS COMPUTED BEFORE BACKJUMPING
+    int lbd = compute_lbd(s, learned_literals, learned_size);
+    record_learned_lbd(s, lbd);
+
+    // HAND SHORT ENOUGH CLAUSES TO THE LIBRARY USER, 0 TERMINATED
+    if (s->learn_callback != NULL && learned_size <= s->learn_max_length) {
+        learned_literals[learned_size] = 0;
+        s->learn_callback(s->learn_data, learned_literals);
+    }
+
+    backtrack(s, backjump_level);
+
+    // ADD NEWLY LEARNED CLAUSE TO THE DATABASE
+    s->num_learned++;
+    int clause_ref = allocate_clause(s, learned_size);
+    remember_learned(s, clause_ref);
+
+    clause* learned_clause = CLAUSE(clause_ref);
+    learned_clause->learned = 1;
+    learned_clause->lbd = lbd;
+    bump_clause_activity(s, clause_ref);
+    learned_clause->size = learned_size;
+    memcpy(learned_clause->literals, learned_literals,
+            sizeof(int) * learned_size);
+
+    // FINISH PROPER INITIALIZING OF THE CLAUSE
+    // most recently assigned variables should be watched
+    // to effectively utilize non-chronological backtrack
+    if (learned_size > 1) attach_clause(s, clause_ref);
+
+    if (s->shared != NULL && learned_size <= SHARE_MAX_SIZE &&
+            (lbd <= SHARE_LBD || learned_size <= SHARE_SIZE)) {
+        export_clause(s, learned_literals, learned_size, lbd);
+    }
+
+    // THE LEARNED CLAUSE IS NOW UNIT, IMPLY ITS CONFLICT LEVEL LITERAL
+    int asserted = learned_literals[0];
+    s->antecedents[abs(asserted)] = learned_size == 2 ?
+        BINARY_ANTECEDENT(learned_literals[1]) : clause_ref;
+    assign(s, abs(asserted), backjump_level, asserted > 0 ? 1 : 0);
+
+    return backjump_level;
+}
+
+// LITERALS OF A CONFLICT OR AN ANTECEDENT. BINARY CLAUSES AREN'T READ FROM
+// THE ARENA: A BINARY CONFLICT WAS LEFT IN binary_conflict BY propagate(),
+// OF A BINARY ANTECEDENT ONLY THE OTHER (FALSE) LITERAL IS RETURNED, WHICH IS
+// ALL THE ANALYSIS NEEDS, AS IT SKIPS THE IMPLIED ONE ANYWAY
+int* reason_literals(solver* s, int reason, int* size) {
+    if (reason == BINARY_CONFLICT) {
+        *size = 2;
+        return s->binary_conflict;
+    }
+    if (IS_BINARY_ANTECEDENT(reason)) {
+        s->binary_reason = BINARY_REASON_LITERAL(reason);
+        *size = 1;
+        return &s->binary_reason;
+    }
+    *size = CLAUSE(reason)->size;
+    return CLAUSE(reason)->literals;
+}
+
+// LEARN CLAUSE FROM CONFLICT USING FIRST UIP ALGORITHM
+// WALK THE TRAIL BACKWARDS, RESOLVING AWAY THE MOST RECENTLY ASSIGNED
+// VARIABLE OF THE CONFLICT LEVEL UNTIL ONLY ONE IS LEFT. INSTEAD OF BUILDING
+// THE RESOLVENTS, THE VARIABLES THAT ARE IN THE CURRENT ONE ARE MARKED seen:
+// THOSE FROM EARLIER LEVELS GO STRAIGHT TO THE LEARNED CLAUSE, THOSE FROM THE
+// CONFLICT LEVEL ARE ONLY COUNTED.
+// THE LEARNED CLAUSE IS WRITTEN TO learned_literals WITH THE UIP AT INDEX 0,
+// ITS SIZE IS RETURNED
+int first_uip(solver* s, int conflict, int decision_level) {
+
+    int learned_size = 1;
+    int open_count = 0;
+    int resolved = 0;
+    int trail_index = s->trail_size - 1;
+    int reason_id = conflict;
+
+    do {
+        int reason_size;
+        int* reason = reason_literals(s, reason_id, &reason_size);
+
+        // LEARNED CLAUSES THAT TAKE PART IN CONFLICTS ARE WORTH KEEPING,
+        // IF THE CLAUSE NOW SPANS FEWER LEVELS THAN BEFORE, UPDATE ITS LBD.
+        // BINARY ONES ARE ALWAYS KEPT
+        if (reason_id >= 0 && CLAUSE(reason_id)->learned) {
+            clause* learned_clause = CLAUSE(reason_id);
+            bump_clause_activity(s, reason_id);
+            if (learned_clause->lbd > GLUE_LBD) {
+                int lbd = compute_lbd(s, reason, reason_size);
+                if (lbd < learned_clause->lbd) learned_clause->lbd = lbd;
+            }
+        }
+
+        for (int i = 0; i < reason_size; i++) {
+            int literal = reason[i];
+            int variable_id = abs(literal);
+
+            // THE ANTECEDENT CONTAINS THE RESOLVED VARIABLE, SKIP IT,
+            // AS WELL AS EVERYTHING FIXED ON LEVEL 0
+            if (variable_id == resolved || s->seen[variable_id] ||
+                    s->levels[variable_id] == 0) {
+                continue;
+            }
+            s->seen[variable_id] = 1;
+            bump_activity(s, variable_id);
+
+            if (s->levels[variable_id] == decision_level) {
+                open_count++;
+            }
+            else {
+                s->learned_literals[learned_size] = literal;
+                learned_size++;
+            }
+        }
+
+        // FIND MOST RECENTLY ASSIGNED VARIABLE THAT IS STILL IN THE CLAUSE
+        while (!s->seen[abs(s->trail[trail_index])]) trail_index--;
+        resolved = abs(s->trail[trail_index]);
+        trail_index--;
+
+        s->seen[resolved] = 0;
+        open_count--;
+        if (open_count > 0) reason_id = s->antecedents[resolved];
+    } while (open_count > 0);
+
+    // THE LAST ONE LEFT FROM THE CONFLICT LEVEL IS THE UIP,
+    // IT IS TRUE ON THE TRAIL SO IT IS FALSE IN THE CLAUSE
+    s->learned_literals[0] =
+        s->values[resolved] > 0 ? -resolved : resolved;
+
+    // MINIMIZATION: DROP EVERY LITERAL WHOSE FALSENESS ALREADY FOLLOWS FROM
+    // THE OTHER LITERALS OF THE CLAUSE. THE LEVELS OF THE CLAUSE ARE HASHED
+    // INTO A BIT MASK TO GIVE UP EARLY ON LITERALS THAT DEPEND ON OTHER LEVELS
+    unsigned int level_mask = 0;
+    for (int i = 1; i < learned_size; i++) {
+        level_mask |= 1u <<
+            (s->levels[abs(s->learned_literals[i])] & 31);
+    }
+
+    s->analyze_to_clear_size = 0;
+    int kept = 1;
+    for (int i = 1; i < learned_size; i++) {
+        int literal = s->learned_literals[i];
+        s->analyze_to_clear[s->analyze_to_clear_size] = literal;
+        s->analyze_to_clear_size++;
+        if (s->antecedents[abs(literal)] == -1 ||
+                !literal_redundant(s, literal, level_mask)) {
+            s->learned_literals[kept] = literal;
+            kept++;
+        }
+    }
+
+    for (int i = 0; i < s->analyze_to_clear_size; i++) {
+        s->seen[abs(s->analyze_to_clear[i])] = 0;
+    }
+    return kept;
+}
+
+// CHECK IF literal (FALSE, ALREADY seen) IS IMPLIED BY THE seen LITERALS BY
+// FOLLOWING ANTECEDENTS DEPTH FIRST. EVERY VARIABLE VISITED ON THE WAY IS
+// MARKED seen AS WELL, SO THAT IT IS NOT EXPLORED TWICE, AND IS REMEMBERED
+// IN analyze_to_clear. IF THE LITERAL TURNS OUT NOT REDUNDANT, THE MARKS OF
+// THIS CALL ARE UNDONE, SINCE THE VISITED VARIABLES ARE NOT IMPLIED EITHER
+int literal_redundant(solver* s, int literal, unsigned int level_mask) {
+
+    int stack_size = 1;
+    int clear_start = s->analyze_to_clear_size;
+    s->analyze_stack[0] = abs(literal);
+
+    while (stack_size > 0) {
+        stack_size--;
+        int variable_id = s->analyze_stack[stack_size];
+        int reason_size;
+        int* reason = reason_literals(s,
+                s->antecedents[variable_id], &reason_size);
+
+        for (int i = 0; i < reason_size; i++) {
+            int reason_var = abs(reason[i]);
+            if (reason_var == variable_id || s->seen[reason_var] ||
+                    s->levels[reason_var] == 0) {
+                continue;
+            }
+
+            // A DECISION OR A VARIABLE FROM A LEVEL NOT IN THE CLAUSE
+            // CAN'T BE IMPLIED BY IT
+            if (s->antecedents[reason_var] == -1 ||
+                    !(level_mask & (1u <<
+                            (s->levels[reason_var] & 31)))) {
+                for (int j = clear_start; j < s->analyze_to_clear_size; j++) {
+                    s->seen[abs(s->analyze_to_clear[j])] = 0;
+                }
+                s->analyze_to_clear_size = clear_start;
+                return 0;
+            }
+
+            s->seen[reason_var] = 1;
+            s->analyze_stack[stack_size] = reason_var;
+            stack_size++;
+            s->analyze_to_clear[s->analyze_to_clear_size] = reason_var;
+            s->analyze_to_clear_size++;
+        }
+    }
+    return 1;
+}
+
+// COUNT DIFFERENT DECISION LEVELS AMONG THE (ASSIGNED) LITERALS
+int compute_lbd(solver* s, int* literals, int size) {
+    s->current_stamp++;
+    int lbd = 0;
+    for (int i = 0; i < size; i++) {
+        int level = s->levels[abs(literals[i])];
+        if (s->level_stamps[level] != s->current_stamp) {
+            s->level_stamps[level] = s->current_stamp;
+            lbd++;
+        }
+    }
+    return lbd;
+}
+
+void bump_clause_activity(solver* s, int clause_ref) {
+    CLAUSE(clause_ref)->activity += s->clause_activity_bump;
+
+    if (CLAUSE(clause_ref)->activity > CLAUSE_RESCALE_LIMIT) {
+        for (int i = 0; i < s->learned_count; i++) {
+            CLAUSE(s->learned_refs[i])->activity /= CLAUSE_RESCALE_LIMIT;
+        }
+        s->clause_activity_bump /= CLAUSE_RESCALE_LIMIT;
+    }
+}
+
+// A CLAUSE IS LOCKED IF IT IS THE ANTECEDENT OF ONE OF ITS (ASSIGNED)
+// LITERALS, THE IMPLIED LITERAL IS ALWAYS literals[0]
+int clause_locked(solver* s, int clause_ref) {
+    clause* c = CLAUSE(clause_ref);
+    if (c->size == 1) return 1;
+    return s->values[c->literals[0]] != 0 &&
+        s->antecedents[abs(c->literals[0])] == clause_ref;
+}
+
+int compare_entries(const void* a, const void* b) {
+    const sort_entry* first = a;
+    const sort_entry* second = b;
+    if (first->primary != second->primary) {
+        return first->primary < second->primary ? -1 : 1;
+    }
+    if (first->secondary != second->secondary) {
+        return first->secondary < second->secondary ? -1 : 1;
+    }
+    return 0;
+}
+
+// DELETE THE LESS USEFUL HALF OF THE LEARNED CLAUSES. GLUE CLAUSES AND
+// CLAUSES THAT ARE CURRENTLY ANTECEDENTS ARE ALWAYS KEPT
+void reduce_learned(solver* s) {
+
+    // LEAST USEFUL FIRST, I.E. LARGEST LBD, THEN LOWEST ACTIVITY
+    sort_entry* order = (malloc(sizeof(sort_entry) * s->learned_count));
+    for (int i = 0; i < s->learned_count; i++) {
+        clause* c = CLAUSE(s->learned_refs[i]);
+        order[i].primary = -(long long)c->lbd;
+        order[i].secondary = c->activity;
+        order[i].value = s->learned_refs[i];
+    }
+    qsort(order, s->learned_count, sizeof(sort_entry), compare_entries);
+    for (int i = 0; i < s->learned_count; i++) {
+        s->learned_refs[i] = order[i].value;
+    }
+    free(order);
+
+    int to_delete = s->learned_count / 2;
+    int kept = 0;
+    for (int i = 0; i < s->learned_count; i++) {
+        int clause_ref = s->learned_refs[i];
+        clause* c = CLAUSE(clause_ref);
+        if (to_delete > 0 && c->lbd > GLUE_LBD && c->size > 2 &&
+                !clause_locked(s, clause_ref)) {
+            proof_delete(s, c->literals, c->size);
+            c->deleted = 1;
+            s->arena_wasted += CLAUSE_WORDS(c->size);
+            to_delete--;
+            s->num_deleted++;
+        }
+        else {
+            s->learned_refs[kept] = clause_ref;
+            kept++;
+        }
+    }
+    s->learned_count = kept;
+    detach_deleted(s);
+    delete_xor_clauses(s);
+
+    // RECLAIM THE SPACE ONCE A GOOD PART OF THE ARENA IS GARBAGE
+    if (s->arena_wasted > s->arena_size / 4) collect_garbage(s);
+}
+
+// DETACH DELETED CLAUSES FROM ALL WATCH LISTS IN ONE SWEEP. BINARY CLAUSES
+// ARE NOT ON THEM
+void detach_deleted(solver* s) {
+    for (int i = 0; i < 2 * (s->num_variables + 1); i++) {
+        watcher_list* list = s->watches + i;
+        int write = 0;
+        for (int read = 0; read < list->size; read++) {
+            if (!CLAUSE(list->watchers[read].clause_ref)->deleted) {
+                list->watchers[write] = list->watchers[read];
+                write++;
+            }
+        }
+        list->size = write;
+    }
+}
+
+// ADD THE CLAUSE TO THE LEARNED CLAUSE DATABASE
+void remember_learned(solver* s, int clause_ref) {
+    if (s->learned_count == s->learned_capacity) {
+        s->learned_capacity = 2 * s->learned_capacity + 1;
+        s->learned_refs = (realloc(s->learned_refs,
+                    s->learned_capacity * sizeof(int)));
+    }
+    s->learned_refs[s->learned_count] = clause_ref;
+    s->learned_count++;
+}
+
+// ---CLAUSE ARENA---
+
+// MAKE SURE words MORE ints FIT AFTER THE END OF THE ARENA,
+// THE ARENA GROWS BY DOUBLING. REFS ARE ints, SO IT STOPS AT INT_MAX WORDS.
+// RETURNS 0 (LEAVING THE ARENA AS IT WAS) IF IT CAN'T GROW THAT MUCH.
+// ALL clause POINTERS ARE INVALID AFTER THIS CALL
+int reserve_arena(solver* s, long long words) {
+    long long needed = s->arena_size + words;
+    if (needed <= s->arena_capacity) return 1;
+    if (needed > INT_MAX) return 0;
+
+    long long capacity = s->arena_capacity == 0 ? 1024 : s->arena_capacity;
+    while (capacity < needed) capacity *= 2;
+    if (capacity > INT_MAX) capacity = INT_MAX;
+    int* arena = (realloc(s->arena, capacity * sizeof(int)));
+    if (arena == NULL) return 0;
+    s->arena = arena;
+    s->arena_capacity = capacity;
+    return 1;
+}
+
+// RESERVE SPACE FOR A CLAUSE OF size LITERALS AT THE END OF THE ARENA.
+// THE HEADER IS CLEARED, THE LITERALS ARE LEFT TO THE CALLER.
+// RETURNS THE REF OF THE NEW CLAUSE.
+// ALL clause POINTERS ARE INVALID AFTER THIS CALL
+int allocate_clause(solver* s, int size) {
+    int words = CLAUSE_WORDS(size);
+    if (!reserve_arena(s, words)) {
+        fprintf(stderr, "OUT OF MEMORY! THE CLAUSE ARENA IS FULL!\n");
+        exit(1);
+    }
+
+    int ref = s->arena_size;
+    s->arena_size += words;
+    memset(CLAUSE(ref), 0, sizeof(clause));
+    CLAUSE(ref)->size = size;
+    return ref;
+}
+
+// MOVE ALL LIVE CLAUSES INTO A FRESH ARENA, KEEPING THEIR ORDER, AND
+// UPDATE EVERY REF POINTING TO THEM: WATCHES, ANTECEDENTS, LEARNED AND
+// XOR CLAUSE LISTS.
+// WHILE COPYING, THE OLD HEADER OF A MOVED CLAUSE REMEMBERS ITS NEW REF
+void collect_garbage(solver* s) {
+
+    int new_capacity = s->arena_size - s->arena_wasted;
+    int* new_arena = (malloc(new_capacity * sizeof(int)));
+    int new_size = 0;
+
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->deleted) continue;
+
+        int words = CLAUSE_WORDS(c->size);
+        memcpy(new_arena + new_size, c, words * sizeof(int));
+        c->relocated = 1;
+        c->scratch[0] = new_size;
+        new_size += words;
+    }
+
+    // WHEN CALLED BY THE PREPROCESSING THERE ARE NO WATCHES YET, OR ONLY THE
+    // EMPTY ONES LEFT BY reset_solver(), POSSIBLY FOR FEWER VARIABLES
+    int num_lists = s->watches == NULL ? 0 : 2 * (s->variable_capacity + 1);
+    for (int i = 0; i < num_lists; i++) {
+        watcher_list* list = s->watches + i;
+        for (int j = 0; j < list->size; j++) {
+            watcher* entry = list->watchers + j;
+            entry->clause_ref = CLAUSE(entry->clause_ref)->scratch[0];
+        }
+    }
+
+    for (int i = 0; i < s->trail_size; i++) {
+        int* antecedent = s->antecedents + abs(s->trail[i]);
+        if (*antecedent < 0) continue;
+        if (CLAUSE(*antecedent)->relocated) {
+            *antecedent = CLAUSE(*antecedent)->scratch[0];
+        }
+        // A LEVEL 0 ANTECEDENT MAY HAVE BEEN DELETED, IT IS NEVER NEEDED
+        else *antecedent = -1;
+    }
+
+    for (int i = 0; i < s->learned_count; i++) {
+        s->learned_refs[i] = CLAUSE(s->learned_refs[i])->scratch[0];
+    }
+    for (int i = 0; i < s->xor_clauses.size; i++) {
+        int* clause_ref = s->xor_clauses.clause_refs + i;
+        *clause_ref = CLAUSE(*clause_ref)->scratch[0];
+    }
+
+    free(s->arena);
+    s->arena = new_arena;
+    s->arena_size = new_size;
+    s->arena_capacity = new_capacity;
+    s->arena_wasted = 0;
+}
+
+// APPEND clause_ref TO THE WATCH LIST OF literal, DOUBLING ITS CAPACITY
+// WHEN FULL, SO THAT THE AMORTIZED COST OF ATTACHING A WATCH IS CONSTANT.
+// blocker IS ANOTHER LITERAL OF THE CLAUSE
+void watch_clause(solver* s, int clause_ref, int literal, int blocker) {
+    watcher_list* list = s->watches + WATCH_INDEX(literal);
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity == 0 ? 4 : 2 * list->capacity;
+        list->watchers = (realloc(list->watchers,
+                    list->capacity * sizeof(watcher)));
+    }
+    list->watchers[list->size].clause_ref = clause_ref;
+    list->watchers[list->size].blocker = blocker;
+    list->size++;
+}
+
+// WATCH THE FIRST TWO LITERALS OF THE CLAUSE, EACH WITH THE OTHER ONE AS
+// BLOCKER. A BINARY CLAUSE IS WATCHED IMPLICITLY: THE BINARY WATCH LIST OF
+// EACH OF ITS LITERALS GETS THE OTHER ONE, SO THAT PROPAGATING IT NEVER
+// TOUCHES THE ARENA
+void attach_clause(solver* s, int clause_ref) {
+    clause* c = CLAUSE(clause_ref);
+    if (c->size == 2) {
+        push_int(s->binary_watches + WATCH_INDEX(c->literals[0]),
+                c->literals[1]);
+        push_int(s->binary_watches + WATCH_INDEX(c->literals[1]),
+                c->literals[0]);
+        return;
+    }
+    watch_clause(s, clause_ref, c->literals[0], c->literals[1]);
+    watch_clause(s, clause_ref, c->literals[1], c->literals[0]);
+}
+
+// APPEND value TO A GROWABLE ARRAY (WATCH LISTS ARE ONLY ONE USE OF THEM)
+void push_int(watch_list* list, int value) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity == 0 ? 4 : 2 * list->capacity;
+        list->clause_refs = (realloc(list->clause_refs,
+                    list->capacity * sizeof(int)));
+    }
+    list->clause_refs[list->size] = value;
+    list->size++;
+}
+
+// ---VSIDS---
+
+// MOVE THE VARIABLE AT heap[index] UP WHILE IT IS MORE ACTIVE THAN ITS PARENT
+void heap_sift_up(solver* s, int index) {
+    int variable_id = s->heap[index];
+    double activity = s->activities[variable_id];
+
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (s->activities[s->heap[parent]] >= activity) break;
+        s->heap[index] = s->heap[parent];
+        s->heap_positions[s->heap[index]] = index;
+        index = parent;
+    }
+    s->heap[index] = variable_id;
+    s->heap_positions[variable_id] = index;
+}
+
+// MOVE THE VARIABLE AT heap[index] DOWN WHILE ONE OF ITS CHILDREN IS MORE
+// ACTIVE
+void heap_sift_down(solver* s, int index) {
+    int variable_id = s->heap[index];
+    double activity = s->activities[variable_id];
+
+    while (2 * index + 1 < s->heap_size) {
+        int child = 2 * index + 1;
+        if (child + 1 < s->heap_size &&
+                s->activities[s->heap[child + 1]] >
+                s->activities[s->heap[child]]) {
+            child++;
+        }
+        if (s->activities[s->heap[child]] <= activity) break;
+        s->heap[index] = s->heap[child];
+        s->heap_positions[s->heap[index]] = index;
+        index = child;
+    }
+    s->heap[index] = variable_id;
+    s->heap_positions[variable_id] = index;
+}
+
+// ADD VARIABLE TO THE HEAP UNLESS IT IS ALREADY THERE
+void heap_insert(solver* s, int variable_id) {
+    if (s->heap_positions[variable_id] >= 0) return;
+    s->heap[s->heap_size] = variable_id;
+    s->heap_size++;
+    heap_sift_up(s, s->heap_size - 1);
+}
+
+// REMOVE AND RETURN THE MOST ACTIVE VARIABLE
+int heap_pop(solver* s) {
+    int top = s->heap[0];
+    s->heap_positions[top] = -1;
+    s->heap_size--;
+    if (s->heap_size > 0) {
+        s->heap[0] = s->heap[s->heap_size];
+        heap_sift_down(s, 0);
+    }
+    return top;
+}
+
+// INCREASE VARIABLE'S ACTIVITY BY THE CURRENT BUMP,
+// SCALE EVERYTHING DOWN IF THE NUMBERS GET TOO LARGE
+void bump_activity(solver* s, int variable_id) {
+    s->activities[variable_id] += s->activity_bump;
+
+    if (s->activities[variable_id] > VSIDS_RESCALE_LIMIT) {
+        for (int i = 1; i <= s->num_variables; i++) {
+            s->activities[i] /= VSIDS_RESCALE_LIMIT;
+        }
+        s->activity_bump /= VSIDS_RESCALE_LIMIT;
+    }
+
+    // SCALING DOESN'T CHANGE THE ORDER, ONLY THIS VARIABLE MOVED
+    if (s->heap_positions[variable_id] >= 0) {
+        heap_sift_up(s, s->heap_positions[variable_id]);
+    }
+}
+
+// MAKE FUTURE BUMPS WORTH MORE THAN THE PAST ONES
+void decay_activities(solver* s) {
+    s->activity_bump /= s->vsids_decay;
+}
+
+// ---RESTARTS---
+
+// i-TH ELEMENT (FROM 0) OF THE LUBY SEQUENCE 1 1 2 1 1 2 4 1 1 2 ...
+int luby(int i) {
+    int size = 1;
+    int power = 1;
+
+    // FIND THE SMALLEST FINISHED SUBSEQUENCE (OF SIZE 2^k - 1) CONTAINING i
+    while (size < i + 1) {
+        size = 2 * size + 1;
+        power *= 2;
+    }
+
+    // i IS EITHER THE LAST ELEMENT OF IT, OR IN ONE OF ITS TWO HALVES
+    while (size - 1 != i) {
+        size = (size - 1) / 2;
+        power /= 2;
+        i = i % size;
+    }
+    return power;
+}
+
+// COUNT THE CONFLICT AND FEED THE LBD OF ITS LEARNED CLAUSE TO THE AVERAGES
+void record_learned_lbd(solver* s, int lbd) {
+    s->conflicts_since_restart++;
+    s->lbd_total_sum += lbd;
+
+    int slot = (s->num_learned + 1) % LBD_WINDOW;
+    if (s->lbd_window_count == LBD_WINDOW) {
+        s->lbd_window_sum -= s->lbd_window[slot];
+    }
+    else s->lbd_window_count++;
+    s->lbd_window[slot] = lbd;
+    s->lbd_window_sum += lbd;
+}
+
+// DECIDE WHETHER TO RESTART NOW, AND IF SO RESET THE COUNTERS
+int restart_due(solver* s) {
+    int due = 0;
+
+    if (s->restart_policy == RESTART_LUBY) {
+        due = s->conflicts_since_restart >= LUBY_UNIT * luby(s->luby_index);
+        if (due) s->luby_index++;
+    }
+    else if (s->restart_policy == RESTART_GLUCOSE) {
+        // RECENT CLAUSES ARE WORSE THAN USUAL -> WE ARE IN A BAD REGION.
+        // AFTER A RESTART THE WINDOW HAS TO FILL UP AGAIN FIRST
+        due = s->lbd_window_count == LBD_WINDOW &&
+            s->lbd_window_sum * GLUCOSE_MARGIN / LBD_WINDOW >
+            (double)s->lbd_total_sum / (s->num_learned + 1);
+        if (due) {
+            s->lbd_window_count = 0;
+            s->lbd_window_sum = 0;
+        }
+    }
+
+    if (due) s->conflicts_since_restart = 0;
+    return due;
+}
+
+// ---PREPROCESSING---
+// THE ORIGINAL FORMULA IS SIMPLIFIED BEFORE THE WATCHES ARE SET UP:
+// LEVEL 0 UNITS ARE PROPAGATED, CLAUSES SUBSUMED BY OTHERS ARE DELETED,
+// SELF-SUBSUMING RESOLUTION REMOVES LITERALS, AND VARIABLES ARE ELIMINATED
+// BY RESOLUTION WHEN THAT DOESN'T GROW THE FORMULA.
+// CLAUSES ARE NEVER SHRUNK IN PLACE (THE ARENA MUST STAY WALKABLE), A
+// STRENGTHENED CLAUSE IS COPIED AND THE ORIGINAL DELETED INSTEAD.
+// WHILE PREPROCESSING, scratch[] OF A CLAUSE HOLDS ITS 64 BIT SIGNATURE
+
+unsigned long long get_signature(solver* s, int clause_ref) {
+    unsigned long long signature;
+    memcpy(&signature, CLAUSE(clause_ref)->scratch, sizeof(signature));
+    return signature;
+}
+
+// ONE BIT PER VARIABLE (MODULO 64): IF C SUBSUMES D, sig(C) & ~sig(D) == 0
+void compute_signature(solver* s, int clause_ref) {
+    clause* c = CLAUSE(clause_ref);
+    unsigned long long signature = 0;
+    for (int i = 0; i < c->size; i++) {
+        signature |= 1ULL << (abs(c->literals[i]) & 63);
+    }
+    memcpy(c->scratch, &signature, sizeof(signature));
+}
+
+void delete_preprocessed_clause(solver* s, int clause_ref) {
+    clause* c = CLAUSE(clause_ref);
+    proof_delete(s, c->literals, c->size);
+    c->deleted = 1;
+    s->arena_wasted += CLAUSE_WORDS(c->size);
+    for (int i = 0; i < c->size; i++) {
+        s->touched[abs(c->literals[i])] = 1;
+    }
+}
+
+// LITERAL IS TRUE ON LEVEL 0, RETURN 0 IF IT IS ALREADY FALSE
+int fix_literal(solver* s, int literal) {
+    int value = literal > 0;
+    if (s->fixed_values[abs(literal)] == !value) return 0;
+    if (s->fixed_values[abs(literal)] == value) return 1;
+    s->fixed_values[abs(literal)] = value;
+    push_int(&s->fixed_queue, literal);
+    return 1;
+}
+
+// ADD THE CLAUSE IN preprocess_buffer TO THE FORMULA. UNITS ARE FIXED
+// INSTEAD, AN EMPTY CLAUSE MEANS UNSAT (RETURNS 0)
+int add_preprocessed_clause(solver* s, int size) {
+    proof_add(s, s->preprocess_buffer, size);
+    if (size == 0) return 0;
+    if (size == 1) return fix_literal(s, s->preprocess_buffer[0]);
+
+    int clause_ref = allocate_clause(s, size);
+    memcpy(CLAUSE(clause_ref)->literals, s->preprocess_buffer,
+            size * sizeof(int));
+    compute_signature(s, clause_ref);
+    for (int i = 0; i < size; i++) {
+        int literal = s->preprocess_buffer[i];
+        push_int(s->occurrences + WATCH_INDEX(literal), clause_ref);
+        s->touched[abs(literal)] = 1;
+    }
+    push_int(&s->subsumption_queue, clause_ref);
+    return 1;
+}
+
+// REPLACE THE CLAUSE WITH A COPY WITHOUT literal. THE COPY IS ADDED FIRST,
+// THE PROOF NEEDS THE ORIGINAL TO DERIVE IT
+int strengthen(solver* s, int clause_ref, int literal) {
+    clause* c = CLAUSE(clause_ref);
+    int size = 0;
+    for (int i = 0; i < c->size; i++) {
+        if (c->literals[i] != literal) {
+            s->preprocess_buffer[size] = c->literals[i];
+            size++;
+        }
+    }
+    int ok = add_preprocessed_clause(s, size);
+    delete_preprocessed_clause(s, clause_ref);
+    s->num_strengthened++;
+    return ok;
+}
+
+// DROP DELETED CLAUSES FROM AN OCCURRENCE LIST, RETURN HOW MANY ARE LEFT
+int live_occurrences(solver* s, int literal) {
+    watch_list* list = s->occurrences + WATCH_INDEX(literal);
+    int write = 0;
+    for (int read = 0; read < list->size; read++) {
+        if (!CLAUSE(list->clause_refs[read])->deleted) {
+            list->clause_refs[write] = list->clause_refs[read];
+            write++;
+        }
+    }
+    list->size = write;
+    return write;
+}
+
+// SIMPLIFY WITH EVERY FIXED LITERAL THAT WAS NOT YET USED: CLAUSES WITH THE
+// LITERAL ARE SATISFIED, ITS NEGATION IS REMOVED FROM THE OTHERS. EACH FIXED
+// LITERAL THEN GETS A UNIT CLAUSE SO THE SEARCH ASSIGNS IT ON LEVEL 0.
+// RETURNS 0 IF UNSAT
+int propagate_fixed(solver* s) {
+    while (s->fixed_queue.size > 0) {
+        s->fixed_queue.size--;
+        int literal = s->fixed_queue.clause_refs[s->fixed_queue.size];
+
+        watch_list* satisfied = s->occurrences + WATCH_INDEX(literal);
+        for (int i = 0; i < satisfied->size; i++) {
+            if (!CLAUSE(satisfied->clause_refs[i])->deleted) {
+                delete_preprocessed_clause(s, satisfied->clause_refs[i]);
+            }
+        }
+        satisfied->size = 0;
+
+        // STRENGTHENING MAY FIX MORE LITERALS, BUT NEVER ADDS TO THIS LIST
+        watch_list* falsified = s->occurrences + WATCH_INDEX(-literal);
+        for (int i = 0; i < falsified->size; i++) {
+            int clause_ref = falsified->clause_refs[i];
+            if (CLAUSE(clause_ref)->deleted) continue;
+            if (!strengthen(s, clause_ref, -literal)) return 0;
+        }
+        falsified->size = 0;
+
+        int unit = allocate_clause(s, 1);
+        CLAUSE(unit)->literals[0] = literal;
+    }
+    return 1;
+}
+
+// USE THE CLAUSE TO SUBSUME OR STRENGTHEN THE CLAUSES IT CAN. ONLY CLAUSES
+// CONTAINING ITS LEAST FREQUENT LITERAL (IN EITHER SIGN) ARE CANDIDATES.
+// RETURNS 0 IF UNSAT
+int subsume_with(solver* s, int clause_ref) {
+    clause* c = CLAUSE(clause_ref);
+    int size = c->size;
+    unsigned long long signature = get_signature(s, clause_ref);
+
+    int best = c->literals[0];
+    int best_count = INT_MAX;
+    for (int i = 0; i < size; i++) {
+        int literal = c->literals[i];
+        int count = s->occurrences[WATCH_INDEX(literal)].size +
+            s->occurrences[WATCH_INDEX(-literal)].size;
+        if (count < best_count) {
+            best = literal;
+            best_count = count;
+        }
+        s->preprocess_marks[WATCH_INDEX(literal)] = 1;
+    }
+
+    int ok = 1;
+    for (int sign = 0; sign < 2 && ok; sign++) {
+        // STRENGTHENING MAY APPEND TO THIS LIST, SO IT IS NOT CACHED
+        watch_list* list = s->occurrences + WATCH_INDEX(sign ? -best : best);
+        for (int i = 0; i < list->size && ok; i++) {
+            int other_ref = list->clause_refs[i];
+            clause* other = CLAUSE(other_ref);
+            if (other_ref == clause_ref || other->deleted ||
+                    other->size < size ||
+                    (signature & ~get_signature(s, other_ref)) != 0) {
+                continue;
+            }
+
+            // COUNT LITERALS OF THE CLAUSE FOUND IN THE OTHER ONE,
+            // AT MOST ONE OF THEM MAY BE NEGATED
+            int found = 0;
+            int negated = 0;
+            for (int j = 0; j < other->size && negated < 2; j++) {
+                int literal = other->literals[j];
+                if (s->preprocess_marks[WATCH_INDEX(literal)]) found++;
+                else if (s->preprocess_marks[WATCH_INDEX(-literal)]) {
+                    found++;
+                    negated = negated == 0 ? literal : 2;
+                }
+            }
+            s->preprocess_steps += other->size;
+
+            if (found < size || negated == 2) continue;
+            if (negated == 0) {
+                delete_preprocessed_clause(s, other_ref);
+                s->num_subsumed++;
+            }
+            else ok = strengthen(s, other_ref, negated);
+        }
+    }
+
+    c = CLAUSE(clause_ref);
+    for (int i = 0; i < size; i++) {
+        s->preprocess_marks[WATCH_INDEX(c->literals[i])] = 0;
+    }
+    return ok;
+}
+
+// TRY SUBSUMING WITH EVERY QUEUED CLAUSE. RETURNS 0 IF UNSAT
+int run_subsumption(solver* s) {
+    while (s->subsumption_queue.size > 0 &&
+            s->preprocess_steps < PREPROCESS_STEP_LIMIT) {
+        s->subsumption_queue.size--;
+        int clause_ref =
+            s->subsumption_queue.clause_refs[s->subsumption_queue.size];
+        if (CLAUSE(clause_ref)->deleted) continue;
+        if (!subsume_with(s, clause_ref)) return 0;
+        if (!propagate_fixed(s)) return 0;
+    }
+    s->subsumption_queue.size = 0;
+    return 1;
+}
+
+// RESOLVE THE TWO CLAUSES ON variable_id INTO preprocess_buffer.
+// RETURNS THE RESOLVENT SIZE, OR -1 IF IT IS A TAUTOLOGY
+int resolve_on(solver* s, int variable_id, int positive_ref, int negative_ref) {
+    clause* positive = CLAUSE(positive_ref);
+    clause* negative = CLAUSE(negative_ref);
+    int size = 0;
+
+    for (int i = 0; i < positive->size; i++) {
+        int literal = positive->literals[i];
+        if (abs(literal) == variable_id) continue;
+        s->preprocess_marks[WATCH_INDEX(literal)] = 1;
+        s->preprocess_buffer[size] = literal;
+        size++;
+    }
+
+    int tautology = 0;
+    for (int i = 0; i < negative->size && !tautology; i++) {
+        int literal = negative->literals[i];
+        if (abs(literal) == variable_id ||
+                s->preprocess_marks[WATCH_INDEX(literal)]) {
+            continue;
+        }
+        if (s->preprocess_marks[WATCH_INDEX(-literal)]) tautology = 1;
+        else {
+            s->preprocess_buffer[size] = literal;
+            size++;
+        }
+    }
+    s->preprocess_steps += positive->size + negative->size;
+
+    for (int i = 0; i < positive->size; i++) {
+        s->preprocess_marks[WATCH_INDEX(positive->literals[i])] = 0;
+    }
+    return tautology ? -1 : size;
+}
+
+// ELIMINATE THE VARIABLE BY REPLACING ALL CLAUSES CONTAINING IT WITH THEIR
+// NON-TAUTOLOGICAL RESOLVENTS, IF THAT DOESN'T MAKE THE FORMULA LARGER.
+// RETURNS 1 IF ELIMINATED, 0 IF NOT, -1 IF UNSAT
+int eliminate_variable(solver* s, int variable_id) {
+    int positive_count = live_occurrences(s, variable_id);
+    int negative_count = live_occurrences(s, -variable_id);
+    int total = positive_count + negative_count;
+    if (total > ELIM_OCCURRENCE_LIMIT) return 0;
+
+    watch_list* positive = s->occurrences + WATCH_INDEX(variable_id);
+    watch_list* negative = s->occurrences + WATCH_INDEX(-variable_id);
+
+    // FIRST ONLY COUNT THE RESOLVENTS
+    int resolvents = 0;
+    for (int i = 0; i < positive_count; i++) {
+        for (int j = 0; j < negative_count; j++) {
+            int size = resolve_on(s, variable_id, positive->clause_refs[i],
+                    negative->clause_refs[j]);
+            if (size < 0) continue;
+            resolvents++;
+            if (resolvents > total || size > ELIM_RESOLVENT_LIMIT) return 0;
+        }
+    }
+
+    // SAVE THE CLAUSES FOR MODEL RECONSTRUCTION
+    for (int sign = 0; sign < 2; sign++) {
+        watch_list* list = sign ? negative : positive;
+        int literal = sign ? -variable_id : variable_id;
+        for (int i = 0; i < list->size; i++) {
+            clause* c = CLAUSE(list->clause_refs[i]);
+            push_int(&s->elimination_stack, literal);
+            for (int j = 0; j < c->size; j++) {
+                if (c->literals[j] != literal) {
+                    push_int(&s->elimination_stack, c->literals[j]);
+                }
+            }
+            push_int(&s->elimination_stack, c->size);
+        }
+    }
+
+    s->eliminated[variable_id] = 1;
+    s->num_eliminated++;
+
+    // ADDING RESOLVENTS MAY GROW THE ARENA, BUT NOT THESE TWO LISTS.
+    // THE CLAUSES ARE ONLY DELETED AFTERWARDS, THE PROOF DERIVES THE
+    // RESOLVENTS FROM THEM
+    for (int i = 0; i < positive_count; i++) {
+        for (int j = 0; j < negative_count; j++) {
+            int size = resolve_on(s, variable_id, positive->clause_refs[i],
+                    negative->clause_refs[j]);
+            if (size >= 0 && !add_preprocessed_clause(s, size)) return -1;
+        }
+    }
+    for (int i = 0; i < positive_count; i++) {
+        delete_preprocessed_clause(s, positive->clause_refs[i]);
+    }
+    for (int i = 0; i < negative_count; i++) {
+        delete_preprocessed_clause(s, negative->clause_refs[i]);
+    }
+    positive->size = 0;
+    negative->size = 0;
+    return 1;
+}
+
+// RUN THE WHOLE PREPROCESSING. RETURNS 0 IF THE FORMULA TURNED OUT UNSAT
+int preprocess(solver* s) {
+
+    s->occurrences = (calloc(2 * (s->num_variables + 1), sizeof(watch_list)));
+    s->fixed_values = (malloc(s->num_variables + 1));
+    memset(s->fixed_values, -1, s->num_variables + 1);
+    s->preprocess_marks = (calloc(2 * (s->num_variables + 1), sizeof(char)));
+    s->preprocess_buffer = (malloc(sizeof(int) * (s->num_variables + 1)));
+    s->eliminated = (calloc(s->num_variables + 1, sizeof(char)));
+    s->touched = (malloc(s->num_variables + 1));
+    memset(s->touched, 1, s->num_variables + 1);
+    if (s->num_xors > 0) freeze_xor_variables(s);
+
+    int ok = 1;
+    int original_end = s->arena_size;
+    for (int ref = 0; ref < original_end && ok; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->size == 1) {
+            ok = fix_literal(s, c->literals[0]);
+            delete_preprocessed_clause(s, ref);
+            continue;
+        }
+        compute_signature(s, ref);
+        for (int i = 0; i < c->size; i++) {
+            push_int(s->occurrences + WATCH_INDEX(c->literals[i]), ref);
+        }
+        push_int(&s->subsumption_queue, ref);
+    }
+
+    if (ok) ok = propagate_fixed(s);
+
+    // VARIABLES WITH FEWER OCCURRENCES ARE TRIED FIRST
+    sort_entry* candidates = (malloc(sizeof(sort_entry) * s->num_variables));
+    for (int round = 0; round < PREPROCESS_ROUNDS && ok; round++) {
+        ok = run_subsumption(s);
+
+        int candidate_count = 0;
+        for (int i = 1; i <= s->num_variables; i++) {
+            if (s->touched[i] && s->fixed_values[i] == -1 &&
+                    !s->eliminated[i] &&
+                    (s->frozen == NULL || !s->frozen[i])) {
+                candidates[candidate_count].primary =
+                    s->occurrences[WATCH_INDEX(i)].size +
+                    s->occurrences[WATCH_INDEX(-i)].size;
+                candidates[candidate_count].secondary = 0;
+                candidates[candidate_count].value = i;
+                candidate_count++;
+            }
+            s->touched[i] = 0;
+        }
+        qsort(candidates, candidate_count, sizeof(sort_entry),
+                compare_entries);
+
+        int eliminated_now = 0;
+        for (int i = 0; i < candidate_count && ok; i++) {
+            if (s->preprocess_steps >= PREPROCESS_STEP_LIMIT) break;
+            // MAY HAVE BEEN FIXED BY AN EARLIER ELIMINATION
+            int variable_id = candidates[i].value;
+            if (s->fixed_values[variable_id] != -1) continue;
+
+            int result = eliminate_variable(s, variable_id);
+            if (result < 0) ok = 0;
+            else {
+                eliminated_now += result;
+                ok = propagate_fixed(s);
+            }
+        }
+        if (eliminated_now == 0) break;
+    }
+    if (ok) ok = run_subsumption(s);
+    free(candidates);
+
+    for (int i = 0; i < 2 * (s->num_variables + 1); i++) {
+        free(s->occurrences[i].clause_refs);
+    }
+    free(s->occurrences);
+    free(s->fixed_values);
+    free(s->preprocess_marks);
+    free(s->touched);
+    free(s->preprocess_buffer);
+    free(s->fixed_queue.clause_refs);
+    free(s->subsumption_queue.clause_refs);
+    s->occurrences = NULL;
+
+    // THE WATCHES ARE SET UP ON A COMPACT ARENA
+    if (s->arena_wasted > 0) collect_garbage(s);
+    return ok;
+}
+
+// GO THROUGH THE CLAUSES OF ELIMINATED VARIABLES FROM THE LAST ELIMINATED
+// ONE BACK, FLIPPING THE ELIMINATED VARIABLE WHEREVER A CLAUSE IS FALSE
+void reconstruct_model(solver* s) {
+    int* stack = s->elimination_stack.clause_refs;
+
+    for (int i = 1; i <= s->num_variables; i++) {
+        if (s->eliminated[i]) {
+            s->values[i] = -1;
+            s->values[-i] = 1;
+        }
+    }
+
+    int end = s->elimination_stack.size;
+    while (end > 0) {
+        int size = stack[end - 1];
+        int start = end - 1 - size;
+
+        int satisfied = 0;
+        for (int i = start; i < end - 1 && !satisfied; i++) {
+            satisfied = s->values[stack[i]] > 0;
+        }
+        if (!satisfied) {
+            s->values[stack[start]] = 1;
+            s->values[-stack[start]] = -1;
+        }
+        end = start;
+    }
+}
+
+// ---INPROCESSING---
+// RUNS ON LEVEL 0 BETWEEN RESTARTS. PROBING ASSIGNS A LITERAL ON LEVEL 1 AND
+// PROPAGATES IT: IF THAT FAILS, THE NEGATION OF THE LITERAL IS TRUE, AND
+// WHAT BOTH LITERALS OF A VARIABLE IMPLY IS TRUE EITHER WAY. LITERALS ON A
+// CYCLE OF BINARY CLAUSES (A STRONGLY CONNECTED COMPONENT OF THE BINARY
+// IMPLICATION GRAPH) ARE EQUIVALENT AND ARE ALL REPLACED BY ONE OF THEM.
+// A REPLACED VARIABLE IS ELIMINATED AS IN THE PREPROCESSING, ITS TWO
+// BINARY CLAUSES GO TO THE ELIMINATION STACK FOR THE MODEL RECONSTRUCTION.
+// VIVIFICATION ASSUMES THE LITERALS OF A LEARNED CLAUSE FALSE ONE BY ONE
+// AND CUTS THE CLAUSE SHORT AS SOON AS THAT FAILS OR IMPLIES THE REST
+
+int inprocess_due(solver* s) {
+    return s->inprocessing && s->shared == NULL &&
+        s->assumption_count == 0 && s->num_conflicts >= s->next_inprocess;
+}
+
+// ONE ROUND OF INPROCESSING. RETURNS 0 IF THE FORMULA TURNED OUT UNSAT
+int inprocess(solver* s) {
+    s->num_inprocessings++;
+    s->inprocess_interval += INPROCESS_INCREMENT;
+    s->next_inprocess = s->num_conflicts + s->inprocess_interval;
+    if (s->eliminated == NULL) {
+        s->eliminated = (calloc(s->num_variables + 1, sizeof(char)));
+    }
+
+    // THE EFFORT SPENT IS RELATIVE TO THE SEARCH SINCE THE LAST TIME.
+    // INPROCESSING MUST NOT CHANGE THE PHASES THE SEARCH SAVED
+    long long search_propagations =
+        s->num_propagations - s->last_inprocess_propagations;
+    double search_seconds = seconds_now() - s->last_inprocess_time;
+    char* phases = (malloc(s->num_variables + 1));
+    memcpy(phases, s->saved_phases, s->num_variables + 1);
+
+    int ok = propagate(s, 0) == NO_CONFLICT &&
+        probe_literals(s, search_propagations);
+
+    int* representatives = (malloc(sizeof(int) * (s->num_variables + 1)));
+    if (ok) ok = find_equivalences(s, representatives);
+
+    // THE REPLACED VARIABLE v AND ITS REPRESENTATIVE r ARE EQUAL:
+    // (v OR -r) AND (-v OR r)
+    for (int i = 1; i <= s->num_variables && ok; i++) {
+        int representative = representatives[i];
+        if (representative == i) continue;
+        push_int(&s->elimination_stack, i);
+        push_int(&s->elimination_stack, -representative);
+        push_int(&s->elimination_stack, 2);
+        push_int(&s->elimination_stack, -i);
+        push_int(&s->elimination_stack, representative);
+        push_int(&s->elimination_stack, 2);
+        s->eliminated[i] = 1;
+        s->unassigned_count--;
+        s->num_substituted++;
+    }
+
+    if (ok) ok = rewrite_clauses(s, representatives);
+    free(representatives);
+    if (ok) ok = vivify_learned(s, search_seconds);
+
+    memcpy(s->saved_phases, phases, s->num_variables + 1);
+    free(phases);
+    rebuild_heap(s);
+    s->last_inprocess_propagations = s->num_propagations;
+    s->last_inprocess_time = seconds_now();
+    return ok;
+}
+
+// PROBE BOTH LITERALS OF THE VARIABLES THAT HAVE BINARY CLAUSES, GOING
+// ROUND THE VARIABLES FROM WHERE THE LAST ROUND STOPPED UNTIL THE EFFORT
+// IS USED UP. RETURNS 0 IF THE FORMULA IS UNSAT
+int probe_literals(solver* s, long long search_propagations) {
+    long long effort = (long long)(PROBE_EFFORT * search_propagations);
+    if (effort < PROBE_MIN_EFFORT) effort = PROBE_MIN_EFFORT;
+    long long limit = s->num_propagations + effort;
+
+    // THE LITERALS THE FIRST PROBE OF A VARIABLE IMPLIED, MARKED IN seen BY
+    // SIGN (1 POSITIVE, 2 NEGATIVE), 4 IS ADDED IF THE SECOND ONE DID TOO
+    int* implied = (malloc(sizeof(int) * s->num_variables));
+
+    int ok = 1;
+    for (int visited = 0; visited < s->num_variables && ok &&
+            s->num_propagations < limit; visited++) {
+        int variable_id = s->probe_next + 1;
+        s->probe_next = (s->probe_next + 1) % s->num_variables;
+        if (s->values[variable_id] != 0 || s->eliminated[variable_id] ||
+                (s->binary_watches[WATCH_INDEX(variable_id)].size == 0 &&
+                 s->binary_watches[WATCH_INDEX(-variable_id)].size == 0)) {
+            continue;
+        }
+
+        int failed = probe(s, variable_id);
+        int implied_count = 0;
+        for (int i = s->level_starts[1] + 1; i < s->trail_size && !failed;
+                i++) {
+            int literal = s->trail[i];
+            implied[implied_count] = literal;
+            implied_count++;
+            s->seen[abs(literal)] = literal > 0 ? 1 : 2;
+        }
+        backtrack(s, 0);
+
+        // THE FIRST FAILED, THE VARIABLE IS FALSE
+        int fixed = -variable_id;
+        if (!failed) {
+            failed = probe(s, -variable_id);
+            for (int i = s->level_starts[1] + 1;
+                    i < s->trail_size && !failed; i++) {
+                int literal = s->trail[i];
+                if (s->seen[abs(literal)] == (literal > 0 ? 1 : 2)) {
+                    s->seen[abs(literal)] += 4;
+                }
+            }
+            backtrack(s, 0);
+            fixed = variable_id;
+        }
+
+        // FOR THE PROOF, A LITERAL IMPLIED BOTH WAYS IS DERIVED FROM THE TWO
+        // IMPLICATIONS AS BINARY CLAUSES
+        int found = 0;
+        if (failed) {
+            proof_add(s, &fixed, 1);
+            assign(s, variable_id, 0, fixed > 0);
+            found++;
+        }
+        for (int i = 0; i < implied_count; i++) {
+            int literal = implied[i];
+            if (s->seen[abs(literal)] > 2 && !failed) {
+                int implications[2][2] = {{-variable_id, literal},
+                    {variable_id, literal}};
+                proof_add(s, implications[0], 2);
+                proof_add(s, implications[1], 2);
+                proof_add(s, &literal, 1);
+                proof_delete(s, implications[0], 2);
+                proof_delete(s, implications[1], 2);
+                assign(s, abs(literal), 0, literal > 0);
+                found++;
+            }
+            s->seen[abs(literal)] = 0;
+        }
+        s->num_probed_units += found;
+        if (found > 0) ok = propagate(s, 0) == NO_CONFLICT;
+    }
+
+    free(implied);
+    return ok;
+}
+
+// ASSIGN literal ON LEVEL 1 AND PROPAGATE IT, THE CALLER BACKTRACKS.
+// RETURNS 1 IF THERE WAS A CONFLICT
+int probe(solver* s, int literal) {
+    s->level_starts[1] = s->trail_size;
+    assign(s, abs(literal), 1, literal > 0);
+    return propagate(s, 1) != NO_CONFLICT;
+}
+
+// TARJAN'S ALGORITHM ON THE BINARY IMPLICATION GRAPH OF THE UNASSIGNED
+// LITERALS, WITHOUT RECURSION: l IMPLIES THE LITERALS IN THE BINARY WATCH
+// LIST OF -l. representatives[v] IS SET TO THE LITERAL v IS REPLACED BY,
+// THE ONE WITH THE SMALLEST VARIABLE IN THE COMPONENT OF v (v ITSELF IF IT
+// IS ALONE), PREFERRING A FROZEN ONE. OTHER FROZEN VARIABLES ARE NOT
+// REPLACED. THE COMPONENT OF -v IS THE NEGATION OF THE ONE OF v, SO THE
+// TWO AGREE. RETURNS 0 IF SOME LITERAL IS EQUIVALENT TO ITS NEGATION
+int find_equivalences(solver* s, int* representatives) {
+    int nodes = 2 * (s->num_variables + 1);
+
+    // NODES ARE WATCH INDEXES. order[n] TELLS WHEN n WAS REACHED (0 IF NOT
+    // YET), lowest[n] THE EARLIEST NODE STILL ON THE STACK THAT n REACHES,
+    // component[n] IS SET WHEN THE COMPONENT OF n IS COMPLETE. path IS THE
+    // DEPTH FIRST SEARCH, next_edge[n] THE NEXT SUCCESSOR OF n TO VISIT
+    int* order = (calloc(nodes, sizeof(int)));
+    int* lowest = (malloc(sizeof(int) * nodes));
+    int* component = (calloc(nodes, sizeof(int)));
+    int* next_edge = (malloc(sizeof(int) * nodes));
+    int* path = (malloc(sizeof(int) * nodes));
+    int* stack = (malloc(sizeof(int) * nodes));
+    int counter = 0;
+    int components = 0;
+    int stack_size = 0;
+    int ok = 1;
+
+    for (int i = 1; i <= s->num_variables; i++) representatives[i] = i;
+
+    for (int root = 2; root < nodes && ok; root++) {
+        if (order[root] != 0 || s->values[INDEX_LITERAL(root)] != 0 ||
+                s->eliminated[root / 2]) {
+            continue;
+        }
+
+        int path_size = 1;
+        path[0] = root;
+        stack[stack_size] = root;
+        stack_size++;
+        counter++;
+        order[root] = counter;
+        lowest[root] = counter;
+        next_edge[root] = 0;
+
+        while (path_size > 0) {
+            int node = path[path_size - 1];
+            watch_list* successors = s->binary_watches + (node ^ 1);
+
+            if (next_edge[node] < successors->size) {
+                int literal = successors->clause_refs[next_edge[node]];
+                int target = WATCH_INDEX(literal);
+                next_edge[node]++;
+                if (s->values[literal] != 0) continue;
+
+                if (order[target] == 0) {
+                    path[path_size] = target;
+                    path_size++;
+                    stack[stack_size] = target;
+                    stack_size++;
+                    counter++;
+                    order[target] = counter;
+                    lowest[target] = counter;
+                    next_edge[target] = 0;
+                }
+                else if (component[target] == 0 &&
+                        order[target] < lowest[node]) {
+                    lowest[node] = order[target];
+                }
+                continue;
+            }
+
+            // ALL SUCCESSORS DONE, BACK TO THE PARENT
+            path_size--;
+            if (path_size > 0 && lowest[node] < lowest[path[path_size - 1]]) {
+                lowest[path[path_size - 1]] = lowest[node];
+            }
+            if (lowest[node] != order[node]) continue;
+
+            // node IS THE FIRST NODE OF A COMPONENT, THE REST OF IT IS ABOVE
+            // IT ON THE STACK
+            components++;
+            int start = stack_size - 1;
+            while (stack[start] != node) start--;
+            int best = INDEX_LITERAL(node);
+            char* frozen = s->frozen;
+            for (int i = start; i < stack_size; i++) {
+                component[stack[i]] = components;
+                int variable_id = stack[i] / 2;
+                int better = variable_id < abs(best);
+                if (frozen != NULL &&
+                        frozen[variable_id] != frozen[abs(best)]) {
+                    better = frozen[variable_id];
+                }
+                if (better) best = INDEX_LITERAL(stack[i]);
+            }
+            for (int i = start; i < stack_size; i++) {
+                int literal = INDEX_LITERAL(stack[i]);
+                if (component[stack[i] ^ 1] == components) ok = 0;
+                if (frozen != NULL && frozen[abs(literal)]) continue;
+                representatives[abs(literal)] = literal > 0 ? best : -best;
+            }
+            stack_size = start;
+        }
+    }
+
+    free(order);
+    free(lowest);
+    free(component);
+    free(next_edge);
+    free(path);
+    free(stack);
+    return ok;
+}
+
+// REPLACE EVERY LITERAL BY ITS REPRESENTATIVE, DROP THE LITERALS THAT ARE
+// FALSE ON LEVEL 0 AND DELETE THE CLAUSES THAT ARE SATISFIED THERE OR
+// BECAME TAUTOLOGIES. A CHANGED CLAUSE IS COPIED AS IN THE PREPROCESSING,
+// OR ASSIGNED IF ONLY ONE LITERAL IS LEFT. THE WATCHES ARE BUILT AGAIN FROM
+// SCRATCH. RETURNS 0 IF A CLAUSE BECAME EMPTY OR THE NEW UNITS CONFLICT
+int rewrite_clauses(solver* s, int* representatives) {
+    // LEVEL 0 ANTECEDENTS ARE NEVER NEEDED, SO THEIR CLAUSES MAY GO TOO
+    for (int i = 0; i < s->trail_size; i++) {
+        s->antecedents[abs(s->trail[i])] = -1;
+    }
+    delete_xor_clauses(s);
+    for (int i = 0; i < 2 * (s->num_variables + 1); i++) {
+        s->watches[i].size = 0;
+        s->binary_watches[i].size = 0;
+    }
+
+    // seen MARKS THE SIGNS ALREADY IN THE CLAUSE AS IN add_clause().
+    // THE PROOF DERIVES THE NEW CLAUSES FROM THE BINARY CLAUSES OF THE
+    // EQUIVALENCES, SO THE OLD ONES ARE ONLY DELETED FROM IT AT THE END
+    int* kept = s->learned_literals;
+    watch_list replaced = {NULL, 0, 0};
+    int end = s->arena_size;
+    int ok = 1;
+    for (int ref = 0; ref < end && ok; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->deleted) continue;
+
+        int kept_size = 0;
+        int satisfied = 0;
+        int changed = 0;
+        for (int i = 0; i < c->size; i++) {
+            int literal = c->literals[i] > 0 ?
+                representatives[c->literals[i]] :
+                -representatives[-c->literals[i]];
+            int variable_id = abs(literal);
+            char sign = literal > 0 ? 1 : 2;
+            if (literal != c->literals[i]) changed = 1;
+
+            if (s->values[literal] > 0) satisfied = 1;
+            else if (s->values[literal] < 0 || (s->seen[variable_id] & sign)) {
+                changed = 1;
+            }
+            else if (s->seen[variable_id]) satisfied = 1;
+            else {
+                s->seen[variable_id] = sign;
+                kept[kept_size] = literal;
+                kept_size++;
+            }
+        }
+        for (int i = 0; i < kept_size; i++) s->seen[abs(kept[i])] = 0;
+
+        if (!satisfied && !changed) {
+            if (c->size > 1) attach_clause(s, ref);
+            continue;
+        }
+
+        c->deleted = 1;
+        s->arena_wasted += CLAUSE_WORDS(c->size);
+        push_int(&replaced, ref);
+        if (satisfied) continue;
+        proof_add(s, kept, kept_size);
+        if (kept_size == 0) {
+            ok = 0;
+            continue;
+        }
+        if (kept_size == 1) {
+            assign(s, abs(kept[0]), 0, kept[0] > 0);
+            continue;
+        }
+
+        int learned = c->learned;
+        int lbd = c->lbd < kept_size ? c->lbd : kept_size;
+        float activity = c->activity;
+        int copy_ref = allocate_clause(s, kept_size);
+        clause* copy = CLAUSE(copy_ref);
+        copy->learned = learned;
+        copy->lbd = lbd;
+        copy->activity = activity;
+        memcpy(copy->literals, kept, sizeof(int) * kept_size);
+        attach_clause(s, copy_ref);
+    }
+
+    for (int i = 0; i < replaced.size; i++) {
+        clause* c = CLAUSE(replaced.clause_refs[i]);
+        proof_delete(s, c->literals, c->size);
+    }
+    free(replaced.clause_refs);
+
+    // THE LEARNED CLAUSES THAT WERE COPIED HAVE NEW REFS
+    s->learned_count = 0;
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        if (CLAUSE(ref)->learned && !CLAUSE(ref)->deleted) {
+            remember_learned(s, ref);
+        }
+    }
+
+    if (s->arena_wasted > s->arena_size / 4) collect_garbage(s);
+    return ok && propagate(s, 0) == NO_CONFLICT;
+}
+
+// VIVIFY THE LEARNED CLAUSES LONGER THAN 2 THAT WERE NOT VIVIFIED YET, THE
+// LOWEST LBD FIRST, FOR AT MOST VIVIFY_EFFORT TIMES THE TIME THE SEARCH
+// TOOK SINCE THE LAST INPROCESSING. THE NEGATIONS OF THE
+// LITERALS OF A CLAUSE ARE DECIDED ONE LEVEL EACH. A LITERAL THAT IS
+// ALREADY FALSE IS IMPLIED FALSE BY THE ONES BEFORE IT AND DROPPED. IF ONE
+// IS ALREADY TRUE, OR DECIDING IT FALSE CONFLICTS, IT AND THE LITERALS
+// KEPT BEFORE IT ARE IMPLIED AND THE REST IS DROPPED. A SHORTENED CLAUSE
+// IS COPIED. RETURNS 0 IF THE FORMULA IS UNSAT
+int vivify_learned(solver* s, double search_seconds) {
+    double deadline = seconds_now() + VIVIFY_EFFORT * search_seconds;
+
+    int candidate_count = 0;
+    sort_entry* candidates = (malloc(sizeof(sort_entry) *
+                (s->learned_count + 1)));
+    for (int i = 0; i < s->learned_count; i++) {
+        clause* c = CLAUSE(s->learned_refs[i]);
+        if (c->vivified || c->size <= 2) continue;
+        candidates[candidate_count].primary = c->lbd;
+        candidates[candidate_count].secondary = -c->activity;
+        candidates[candidate_count].value = s->learned_refs[i];
+        candidate_count++;
+    }
+    qsort(candidates, candidate_count, sizeof(sort_entry), compare_entries);
+
+    int* kept = s->learned_literals;
+    int ok = 1;
+    for (int i = 0; i < candidate_count && ok &&
+            seconds_now() < deadline; i++) {
+        int clause_ref = candidates[i].value;
+        CLAUSE(clause_ref)->vivified = 1;
+
+        // PROPAGATION MOVES THE LITERALS OF THE CLAUSE AROUND, SO THEY ARE
+        // WORKED ON AS A COPY, WHICH THE KEPT ONES ARE COMPACTED INTO
+        int size = CLAUSE(clause_ref)->size;
+        memcpy(kept, CLAUSE(clause_ref)->literals, sizeof(int) * size);
+        int kept_size = 0;
+        int level = 0;
+        for (int j = 0; j < size; j++) {
+            int literal = kept[j];
+            if (s->values[literal] < 0) continue;
+
+            kept[kept_size] = literal;
+            kept_size++;
+            if (s->values[literal] > 0) break;
+
+            level++;
+            s->level_starts[level] = s->trail_size;
+            assign(s, abs(literal), level, literal < 0);
+            if (propagate(s, level) != NO_CONFLICT) break;
+        }
+        backtrack(s, 0);
+        if (kept_size == size) continue;
+
+        // THE OLD CLAUSE STAYS WATCHED UNTIL THE END, IT IS IMPLIED BY THE
+        // NEW ONE ANYWAY
+        proof_add(s, kept, kept_size);
+        clause* c = CLAUSE(clause_ref);
+        proof_delete(s, c->literals, size);
+        c->deleted = 1;
+        s->arena_wasted += CLAUSE_WORDS(size);
+        s->num_vivified++;
+        // A SINGLE LITERAL LEFT IS EITHER TRUE ON LEVEL 0 ALREADY OR A UNIT
+        if (kept_size == 1) {
+            if (s->values[kept[0]] == 0) {
+                assign(s, abs(kept[0]), 0, kept[0] > 0);
+                ok = propagate(s, 0) == NO_CONFLICT;
+            }
+            continue;
+        }
+
+        int lbd = c->lbd < kept_size ? c->lbd : kept_size;
+        float activity = c->activity;
+        int copy_ref = allocate_clause(s, kept_size);
+        clause* copy = CLAUSE(copy_ref);
+        copy->learned = 1;
+        copy->vivified = 1;
+        copy->lbd = lbd;
+        copy->activity = activity;
+        memcpy(copy->literals, kept, sizeof(int) * kept_size);
+        attach_clause(s, copy_ref);
+        remember_learned(s, copy_ref);
+    }
+    free(candidates);
+
+    int live = 0;
+    for (int i = 0; i < s->learned_count; i++) {
+        if (!CLAUSE(s->learned_refs[i])->deleted) {
+            s->learned_refs[live] = s->learned_refs[i];
+            live++;
+        }
+    }
+    s->learned_count = live;
+    detach_deleted(s);
+    if (s->arena_wasted > s->arena_size / 4) collect_garbage(s);
+    return ok;
+}
+
+// PUT EXACTLY THE UNASSIGNED VARIABLES THAT ARE NOT ELIMINATED ON THE HEAP
+void rebuild_heap(solver* s) {
+    s->heap_size = 0;
+    for (int i = 1; i <= s->num_variables; i++) s->heap_positions[i] = -1;
+    for (int i = 1; i <= s->num_variables; i++) {
+        if (s->values[i] == 0 && !s->eliminated[i]) heap_insert(s, i);
+    }
+}
+
+// ---XOR CONSTRAINTS---
+// AN XOR CONSTRAINT SAYS THAT AN ODD (PARITY 1) OR EVEN (PARITY 0) NUMBER OF
+// ITS VARIABLES IS TRUE. AS CLAUSES IT TAKES ALL 2^(k-1) SIGN PATTERNS OF
+// ITS k VARIABLES THAT THE PARITY FORBIDS, WHICH IS HOW recover_xors() FINDS
+// THEM. THE SEARCH KEEPS THE XORS OF A GROUP IN REDUCED ROW ECHELON FORM
+// OVER THE UNASSIGNED VARIABLES: EVERY ROW WITH AN UNASSIGNED VARIABLE HAS
+// ONE (ITS PIVOT) THAT NO OTHER ROW HAS. A ROW WHOSE ONLY UNASSIGNED
+// VARIABLE IS ITS PIVOT IMPLIES IT, A ROW WITHOUT ONE CAN BE FALSE. THE
+// CLAUSE EXPLAINING THAT IS ADDED AS A LEARNED CLAUSE, SO THE CONFLICT
+// ANALYSIS DOESN'T NEED TO KNOW ABOUT THE XORS
+
+void add_xor(solver* s, const int* variables, int size, int parity) {
+    push_int(&s->xors, size);
+    push_int(&s->xors, parity);
+    for (int i = 0; i < size; i++) push_int(&s->xors, variables[i]);
+    s->num_xors++;
+}
+
+// FIND THE XORS ENCODED BY CLAUSES: THE CLAUSES OF EACH SIZE FROM 3 UP TO
+// XOR_MAX_SIZE ARE SORTED BY A HASH OF THEIR VARIABLES, A RUN WITH THE SAME
+// VARIABLES HAS A BIT FOR EACH SIGN PATTERN IN patterns. THE CLAUSES STAY,
+// THE XORS ARE ADDED TO THEM. GROUPS OF RECOVERED XORS TOO SMALL TO GAIN
+// ANYTHING OR TOO LARGE TO ELIMINATE QUICKLY ARE DROPPED AGAIN.
+// RETURNS THE NUMBER OF XORS KEPT
+int recover_xors(solver* s) {
+    int count = 0;
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (!c->deleted && !c->learned && c->size >= 3 &&
+                c->size <= XOR_MAX_SIZE) {
+            count++;
+        }
+    }
+    if (count == 0) return 0;
+
+    // A CLAUSE'S LITERALS SORTED BY VARIABLE, KEYED BY ITS VARIABLES
+    sort_entry* entries = (malloc(sizeof(sort_entry) * count));
+    int sorted[XOR_MAX_SIZE];
+    count = 0;
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->deleted || c->learned || c->size < 3 ||
+                c->size > XOR_MAX_SIZE) {
+            continue;
+        }
+        for (int i = 0; i < c->size; i++) {
+            int literal = c->literals[i];
+            int j = i;
+            while (j > 0 && abs(c->literals[j - 1]) > abs(literal)) {
+                c->literals[j] = c->literals[j - 1];
+                j--;
+            }
+            c->literals[j] = literal;
+        }
+        unsigned long long hash = c->size;
+        for (int i = 0; i < c->size; i++) {
+            hash = hash * 0x9e3779b97f4a7c15ULL + abs(c->literals[i]);
+        }
+        entries[count].primary = (long long)hash;
+        entries[count].secondary = 0;
+        entries[count].value = ref;
+        count++;
+    }
+    qsort(entries, count, sizeof(sort_entry), compare_entries);
+
+    int found = 0;
+    for (int start = 0; start < count; ) {
+        int end = start + 1;
+        while (end < count && entries[end].primary == entries[start].primary) {
+            end++;
+        }
+
+        // BIT i OF A PATTERN IS SET IF THE i-TH VARIABLE IS NEGATIVE. THE
+        // CLAUSE FORBIDS THE ASSIGNMENT MAKING EXACTLY THOSE TRUE. A RUN
+        // THAT ISN'T ALL THE SAME VARIABLES IS A HASH COLLISION, WHAT ISN'T
+        // LIKE THE FIRST CLAUSE IS IGNORED
+        clause* first = CLAUSE(entries[start].value);
+        int size = first->size;
+        for (int i = 0; i < size; i++) sorted[i] = abs(first->literals[i]);
+        unsigned long long patterns = 0;
+        for (int i = start; i < end; i++) {
+            clause* c = CLAUSE(entries[i].value);
+            int pattern = 0;
+            int same = c->size == size;
+            for (int j = 0; j < size && same; j++) {
+                same = abs(c->literals[j]) == sorted[j];
+                if (c->literals[j] < 0) pattern |= 1 << j;
+            }
+            if (same) patterns |= 1ULL << pattern;
+        }
+
+        // ALL THE PATTERNS WITH AN EVEN NUMBER OF TRUE VARIABLES FORBIDDEN
+        // MEANS PARITY 1, ALL THE ODD ONES PARITY 0
+        unsigned long long even = 0;
+        for (int pattern = 0; pattern < (1 << size); pattern++) {
+            if (__builtin_popcount(pattern) % 2 == 0) even |= 1ULL << pattern;
+        }
+        unsigned long long all = size == 6 ? ~0ULL : (1ULL << (1 << size)) - 1;
+        if ((patterns & even) == even) {
+            add_xor(s, sorted, size, 1 | XOR_RECOVERED);
+            found++;
+        }
+        if ((patterns & (all ^ even)) == (all ^ even)) {
+            add_xor(s, sorted, size, XOR_RECOVERED);
+            found++;
+        }
+        start = end;
+    }
+    free(entries);
+    if (found == 0) return 0;
+
+    // COUNT THE XORS OF EACH GROUP, NEGATIVE IF THERE IS ONE FROM THE INPUT,
+    // WHICH ARE ALWAYS KEPT
+    int* groups = group_xors(s);
+    int* sizes = (calloc(s->num_variables + 1, sizeof(int)));
+    int* xors = s->xors.clause_refs;
+    for (int i = 0, k = 0; i < s->xors.size; i += 2 + xors[i], k++) {
+        if (xors[i + 1] & XOR_RECOVERED) {
+            if (sizes[groups[k]] >= 0) sizes[groups[k]]++;
+        }
+        else sizes[groups[k]] = -1;
+    }
+
+    int kept = 0;
+    int write = 0;
+    int num_xors = 0;
+    for (int i = 0, k = 0; i < s->xors.size; k++) {
+        int words = 2 + xors[i];
+        int group_size = sizes[groups[k]];
+        if (group_size < 0 || (group_size >= 2 &&
+                    group_size <= GAUSS_MAX_ROWS)) {
+            if (xors[i + 1] & XOR_RECOVERED) kept++;
+            memmove(xors + write, xors + i, sizeof(int) * words);
+            write += words;
+            num_xors++;
+        }
+        i += words;
+    }
+    s->xors.size = write;
+    s->num_xors = num_xors;
+    free(groups);
+    free(sizes);
+    return kept;
+}
+
+// FOLLOW THE PARENTS UP TO THE ROOT, HALVING THE PATH ON THE WAY
+int find_group(int* parents, int variable_id) {
+    while (parents[variable_id] != variable_id) {
+        parents[variable_id] = parents[parents[variable_id]];
+        variable_id = parents[variable_id];
+    }
+    return variable_id;
+}
+
+// GROUP THE XORS THAT SHARE VARIABLES, DIRECTLY OR THROUGH OTHER XORS, WITH
+// UNION-FIND. RETURNS AN ARRAY WITH THE GROUP OF EVERY XOR IN THE ORDER OF
+// xors, WHICH IS THE SMALLEST VARIABLE OF THE GROUP (0 FOR AN EMPTY XOR)
+int* group_xors(solver* s) {
+    int* parents = (malloc(sizeof(int) * (s->num_variables + 1)));
+    for (int i = 0; i <= s->num_variables; i++) parents[i] = i;
+
+    int* xors = s->xors.clause_refs;
+    for (int i = 0; i < s->xors.size; i += 2 + xors[i]) {
+        for (int j = 1; j < xors[i]; j++) {
+            int first = find_group(parents, xors[i + 2]);
+            int other = find_group(parents, xors[i + 2 + j]);
+            if (first < other) parents[other] = first;
+            else parents[first] = other;
+        }
+    }
+
+    int* groups = (malloc(sizeof(int) * (s->num_xors + 1)));
+    for (int i = 0, k = 0; i < s->xors.size; i += 2 + xors[i], k++) {
+        groups[k] = xors[i] == 0 ? 0 : find_group(parents, xors[i + 2]);
+    }
+    free(parents);
+    return groups;
+}
+
+void freeze_xor_variables(solver* s) {
+    free(s->frozen);
+    s->frozen = (calloc(s->num_variables + 1, sizeof(char)));
+    int* xors = s->xors.clause_refs;
+    for (int i = 0; i < s->xors.size; i += 2 + xors[i]) {
+        for (int j = 0; j < xors[i]; j++) s->frozen[xors[i + 2 + j]] = 1;
+    }
+}
+
+// CHECK THE XORS AGAINST THE ASSIGNMENT OF THE SOLVER, COMPLETED BY values
+// FOR THE UNASSIGNED VARIABLES (BY VARIABLE ID, 1 TRUE, 0 FALSE, AS THE
+// LOCAL SEARCH HAS IT)
+int xors_satisfied(solver* s, const char* values) {
+    int* xors = s->xors.clause_refs;
+    for (int i = 0; i < s->xors.size; i += 2 + xors[i]) {
+        int parity = 0;
+        for (int j = 0; j < xors[i]; j++) {
+            int variable_id = xors[i + 2 + j];
+            int value = s->values[variable_id];
+            parity ^= value != 0 ? value > 0 : values[variable_id];
+        }
+        if (parity != (xors[i + 1] & 1)) return 0;
+    }
+    return 1;
+}
+
+// BUILD ONE MATRIX PER GROUP OF XORS, ITS COLUMNS ARE THE VARIABLES OF THE
+// GROUP. THE ELIMINATION IS LEFT TO THE FIRST gauss_propagate(). AN EMPTY
+// XOR THAT SHOULD BE TRUE MAKES THE FORMULA UNSAT
+void start_gauss(solver* s) {
+    freeze_xor_variables(s);
+    int* groups = group_xors(s);
+    int* matrix_of = (malloc(sizeof(int) * (s->num_variables + 1)));
+    int* columns = (malloc(sizeof(int) * (s->num_variables + 1)));
+    memset(matrix_of, -1, sizeof(int) * (s->num_variables + 1));
+    memset(columns, -1, sizeof(int) * (s->num_variables + 1));
+    s->matrices = (calloc(s->num_xors, sizeof(gauss)));
+    s->num_matrices = 0;
+
+    // FIRST COUNT THE ROWS AND NUMBER THE COLUMNS OF EVERY MATRIX
+    int* xors = s->xors.clause_refs;
+    for (int i = 0, k = 0; i < s->xors.size; i += 2 + xors[i], k++) {
+        if (xors[i] == 0) {
+            if (xors[i + 1] & 1) s->inconsistent = 1;
+            continue;
+        }
+        if (matrix_of[groups[k]] < 0) {
+            matrix_of[groups[k]] = s->num_matrices;
+            s->num_matrices++;
+        }
+        gauss* g = s->matrices + matrix_of[groups[k]];
+        g->num_rows++;
+        for (int j = 0; j < xors[i]; j++) {
+            int variable_id = xors[i + 2 + j];
+            if (columns[variable_id] < 0) {
+                columns[variable_id] = g->num_columns;
+                g->num_columns++;
+            }
+        }
+    }
+
+    // THE ORIGINAL GETS ONE MORE COPY FOR LEVEL 0 RIGHT AWAY
+    for (int i = 0; i < s->num_matrices; i++) {
+        gauss* g = s->matrices + i;
+        g->words = (g->num_columns + 63) / 64;
+        g->variables = (malloc(sizeof(int) * g->num_columns));
+        g->capacity = 2;
+        g->rows = (calloc((size_t)g->capacity * g->num_rows * g->words,
+                    sizeof(unsigned long long)));
+        g->parities = (calloc(g->capacity * g->num_rows, sizeof(char)));
+        g->pivots = (malloc(sizeof(int) * g->capacity * g->num_rows));
+        memset(g->pivots, -1, sizeof(int) * g->num_rows);
+        g->levels = (malloc(sizeof(int) * g->capacity));
+        g->levels[0] = -1;
+        g->count = 1;
+        g->free_mask = (malloc(sizeof(unsigned long long) * g->words));
+        g->true_mask = (malloc(sizeof(unsigned long long) * g->words));
+        g->num_rows = 0;
+    }
+
+    for (int i = 0, k = 0; i < s->xors.size; i += 2 + xors[i], k++) {
+        if (xors[i] == 0) continue;
+        gauss* g = s->matrices + matrix_of[groups[k]];
+        unsigned long long* row = g->rows + (size_t)g->num_rows * g->words;
+        for (int j = 0; j < xors[i]; j++) {
+            int variable_id = xors[i + 2 + j];
+            int column = columns[variable_id];
+            g->variables[column] = variable_id;
+            row[column / 64] |= 1ULL << (column % 64);
+        }
+        g->parities[g->num_rows] = xors[i + 1] & 1;
+        g->num_rows++;
+    }
+
+    free(groups);
+    free(matrix_of);
+    free(columns);
+}
+
+// MAKE THE CURRENT COPY OF THE MATRIX ONE THAT decision_level MAY CHANGE.
+// IF THE LAST ONE IS FROM A LOWER LEVEL, IT IS COPIED, UNLESS THERE ARE
+// ALREADY GAUSS_MAX_COPIES: THEN IT IS TAKEN OVER, THE ROWS STAY
+// EQUIVALENT, BUT BACKTRACKING BELOW decision_level WILL DROP IT. ALL
+// POINTERS INTO THE MATRIX ARE INVALID AFTER THIS CALL
+void gauss_copy(gauss* g, int decision_level) {
+    int last = g->count - 1;
+    if (g->levels[last] == decision_level) return;
+    if (g->count == GAUSS_MAX_COPIES) {
+        g->levels[last] = decision_level;
+        return;
+    }
+
+    size_t words = (size_t)g->num_rows * g->words;
+    if (g->count == g->capacity) {
+        g->capacity *= 2;
+        g->rows = (realloc(g->rows,
+                    sizeof(unsigned long long) * words * g->capacity));
+        g->parities = (realloc(g->parities, g->num_rows * g->capacity));
+        g->pivots = (realloc(g->pivots,
+                    sizeof(int) * g->num_rows * g->capacity));
+        g->levels = (realloc(g->levels, sizeof(int) * g->capacity));
+    }
+    memcpy(g->rows + words * g->count, g->rows + words * last,
+            sizeof(unsigned long long) * words);
+    memcpy(g->parities + g->num_rows * g->count,
+            g->parities + g->num_rows * last, g->num_rows);
+    memcpy(g->pivots + g->num_rows * g->count,
+            g->pivots + g->num_rows * last, sizeof(int) * g->num_rows);
+    g->levels[g->count] = decision_level;
+    g->count++;
+}
+
+// PROPAGATE ALL THE MATRICES. RETURNS THE REF OF A CONFLICTING CLAUSE OR
+// NO_CONFLICT, WHAT THE XORS IMPLY IS ASSIGNED AND LEFT TO propagate()
+int gauss_propagate(solver* s, int decision_level) {
+    for (int i = 0; i < s->num_matrices; i++) {
+        int conflict = gauss_update(s, s->matrices + i, decision_level);
+        if (conflict != NO_CONFLICT) return conflict;
+    }
+    return NO_CONFLICT;
+}
+
+// BRING THE MATRIX BACK TO REDUCED ROW ECHELON FORM FOR THE CURRENT
+// ASSIGNMENT: A ROW WHOSE PIVOT WAS ASSIGNED TAKES ONE OF ITS UNASSIGNED
+// COLUMNS INSTEAD AND IS ADDED TO THE OTHER ROWS THAT HAVE IT. THEN EVERY
+// ROW IS CHECKED. ONLY ROWS WITH A PIVOT HAVE UNASSIGNED COLUMNS, SO ONLY
+// THEY IMPLY ANYTHING (AND NOTHING ANOTHER ROW NEEDS), ONLY THE OTHERS
+// CONFLICT
+int gauss_update(solver* s, gauss* g, int decision_level) {
+    int words = g->words;
+    unsigned long long* free_mask = g->free_mask;
+    unsigned long long* true_mask = g->true_mask;
+    memset(free_mask, 0, sizeof(unsigned long long) * words);
+    memset(true_mask, 0, sizeof(unsigned long long) * words);
+    for (int column = 0; column < g->num_columns; column++) {
+        int value = s->values[g->variables[column]];
+        if (value == 0) free_mask[column / 64] |= 1ULL << (column % 64);
+        else if (value > 0) true_mask[column / 64] |= 1ULL << (column % 64);
+    }
+
+    size_t matrix_words = (size_t)g->num_rows * words;
+    unsigned long long* rows = g->rows + matrix_words * (g->count - 1);
+    char* parities = g->parities + g->num_rows * (g->count - 1);
+    int* pivots = g->pivots + g->num_rows * (g->count - 1);
+
+    for (int r = 0; r < g->num_rows; r++) {
+        int pivot = pivots[r];
+        if (pivot >= 0 && (free_mask[pivot / 64] >> (pivot % 64) & 1)) {
+            continue;
+        }
+        unsigned long long* row = rows + (size_t)r * words;
+        int column = -1;
+        for (int w = 0; w < words && column < 0; w++) {
+            unsigned long long bits = row[w] & free_mask[w];
+            if (bits != 0) column = 64 * w + __builtin_ctzll(bits);
+        }
+        if (column == pivot) continue;
+
+        gauss_copy(g, decision_level);
+        rows = g->rows + matrix_words * (g->count - 1);
+        parities = g->parities + g->num_rows * (g->count - 1);
+        pivots = g->pivots + g->num_rows * (g->count - 1);
+        row = rows + (size_t)r * words;
+        pivots[r] = column;
+        if (column < 0) continue;
+
+        int word = column / 64;
+        unsigned long long bit = 1ULL << (column % 64);
+        for (int other = 0; other < g->num_rows; other++) {
+            unsigned long long* target = rows + (size_t)other * words;
+            if (other == r || !(target[word] & bit)) continue;
+            for (int w = 0; w < words; w++) target[w] ^= row[w];
+            parities[other] ^= parities[r];
+        }
+    }
+
+    for (int r = 0; r < g->num_rows; r++) {
+        unsigned long long* row = rows + (size_t)r * words;
+        int free_count = 0;
+        int true_parity = 0;
+        for (int w = 0; w < words && free_count < 2; w++) {
+            free_count += __builtin_popcountll(row[w] & free_mask[w]);
+            true_parity ^= __builtin_popcountll(row[w] & true_mask[w]) & 1;
+        }
+        if (free_count > 1) continue;
+
+        // THE VALUE THE UNASSIGNED COLUMN NEEDS, OR 1 IF THE ROW IS FALSE
+        int value = parities[r] ^ true_parity;
+        if (free_count == 0) {
+            if (value == 0) continue;
+            s->num_xor_conflicts++;
+            return add_xor_clause(s, g, row, 0, decision_level);
+        }
+
+        int column = pivots[r];
+        int variable_id = g->variables[column];
+        int literal = value ? variable_id : -variable_id;
+        add_xor_clause(s, g, row, literal, decision_level);
+        free_mask[column / 64] &= ~(1ULL << (column % 64));
+        if (value) true_mask[column / 64] |= 1ULL << (column % 64);
+        s->num_xor_propagations++;
+    }
+    return NO_CONFLICT;
+}
+
+// THE CLAUSE OF THE ROW UNDER THE CURRENT ASSIGNMENT: THE FALSE LITERALS OF
+// ITS ASSIGNED VARIABLES, WITHOUT THOSE FROM LEVEL 0. FOR AN IMPLICATION
+// implied COMES FIRST AND IS ASSIGNED WITH THE CLAUSE AS ANTECEDENT (implied
+// IS 0 FOR A CONFLICT). THE NEXT LITERALS ARE THE ONES FROM THE HIGHEST
+// LEVELS. THE MATRIX DOES THE PROPAGATING, SO THE CLAUSE IS NOT WATCHED AND
+// ONLY KEPT UNTIL delete_xor_clauses(), A BINARY ONE ISN'T EVEN STORED
+// (SEE BINARY_ANTECEDENT). A UNIT IS A FACT LIKE THE ONES FROM THE INPUT.
+// RETURNS THE CONFLICT OR THE REF OF THE CLAUSE
+int add_xor_clause(solver* s, gauss* g, unsigned long long* row,
+        int implied, int decision_level) {
+    int* literals = s->learned_literals;
+    int size = 0;
+    if (implied != 0) {
+        literals[0] = implied;
+        size++;
+    }
+    for (int w = 0; w < g->words; w++) {
+        unsigned long long bits = row[w];
+        while (bits != 0) {
+            int variable_id = g->variables[64 * w + __builtin_ctzll(bits)];
+            bits &= bits - 1;
+            if (s->values[variable_id] == 0 || s->levels[variable_id] == 0) {
+                continue;
+            }
+            literals[size] = s->values[variable_id] > 0 ?
+                -variable_id : variable_id;
+            size++;
+        }
+    }
+
+    for (int i = implied != 0; i < 2 && i < size; i++) {
+        int latest = i;
+        for (int j = i + 1; j < size; j++) {
+            if (s->levels[abs(literals[j])] >
+                    s->levels[abs(literals[latest])]) {
+                latest = j;
+            }
+        }
+        int tmp = literals[i];
+        literals[i] = literals[latest];
+        literals[latest] = tmp;
+    }
+
+    int clause_ref = BINARY_CONFLICT;
+    if (size == 2 && implied == 0) {
+        s->binary_conflict[0] = literals[0];
+        s->binary_conflict[1] = literals[1];
+    }
+    else if (size != 2) {
+        clause_ref = allocate_clause(s, size);
+        clause* added = CLAUSE(clause_ref);
+        memcpy(added->literals, literals, sizeof(int) * size);
+        if (size > 2) {
+            added->learned = 1;
+            added->xor_reason = 1;
+            added->lbd = size;
+            push_int(&s->xor_clauses, clause_ref);
+        }
+    }
+
+    if (implied != 0) {
+        s->antecedents[abs(implied)] = size == 2 ?
+            BINARY_ANTECEDENT(literals[1]) : clause_ref;
+        assign(s, abs(implied), decision_level, implied > 0);
+    }
+    return clause_ref;
+}
+
+// DELETE THE CLAUSES OF THE XORS THAT ARE NO LONGER ANTECEDENTS
+void delete_xor_clauses(solver* s) {
+    int kept = 0;
+    for (int i = 0; i < s->xor_clauses.size; i++) {
+        int clause_ref = s->xor_clauses.clause_refs[i];
+        clause* c = CLAUSE(clause_ref);
+        if (clause_locked(s, clause_ref)) {
+            s->xor_clauses.clause_refs[kept] = clause_ref;
+            kept++;
+            continue;
+        }
+        c->deleted = 1;
+        s->arena_wasted += CLAUSE_WORDS(c->size);
+    }
+    s->xor_clauses.size = kept;
+}
+
+void free_xors(solver* s) {
+    for (int i = 0; i < s->num_matrices; i++) {
+        gauss* g = s->matrices + i;
+        free(g->variables);
+        free(g->rows);
+        free(g->parities);
+        free(g->pivots);
+        free(g->levels);
+        free(g->free_mask);
+        free(g->true_mask);
+    }
+    free(s->matrices);
+    free(s->frozen);
+    free(s->xors.clause_refs);
+    free(s->xor_clauses.clause_refs);
+}
+
+// ---LOCAL SEARCH---
+// PROBSAT OVER THE IRREDUNDANT CLAUSES. ON SATISFIABLE RANDOM FORMULAS IT
+// FINDS A MODEL FAR SOONER THAN THE SEARCH. IT RUNS ON ITS OWN IN
+// solve_local_search(), OR NOW AND THEN FROM decide(), WHICH CONTINUES FROM
+// THE BEST ASSIGNMENT IT FOUND AS ITS SAVED PHASES
+
+int walk_due(solver* s) {
+    return s->walking && s->assumption_count == 0 &&
+        s->num_conflicts >= s->next_walk;
+}
+
+// RUN THE LOCAL SEARCH ON LEVEL 0 FROM THE SAVED PHASES, FOR AT MOST
+// max_flips FLIPS. IF IT FINDS A MODEL, IT IS ASSIGNED (SEE
+// take_walk_model()) AND 1 IS RETURNED. OTHERWISE THE BEST ASSIGNMENT IT SAW
+// BECOMES THE SAVED PHASES
+int walk(solver* s, long long max_flips) {
+    s->num_walks++;
+    s->walk_interval += WALK_INCREMENT;
+    s->next_walk = s->num_conflicts + s->walk_interval;
+    s->last_walk_propagations = s->num_propagations;
+
+    walker w;
+    start_walk(s, &w);
+
+    // EVERY RUN (AND EVERY SOLVER OF A PORTFOLIO) WALKS DIFFERENTLY
+    unsigned long long random =
+        0x9e3779b97f4a7c15ULL * (s->num_walks + 64ULL * s->id);
+    long long flips = 0;
+    while (w.false_count > 0 && flips < max_flips) {
+        int clause_index = w.false_clauses[xorshift(&random) % w.false_count];
+        walk_flip(&w, walk_pick(&w, clause_index, &random));
+        flips++;
+        if (w.false_count < w.best_false) save_best_walk(&w);
+    }
+    s->num_flips += flips;
+
+    // THE XORS FROM THE INPUT ARE NOT AMONG THE CLAUSES
+    int found = w.false_count == 0 && xors_satisfied(s, w.values);
+    if (found) take_walk_model(s, &w);
+    else {
+        for (int i = 1; i <= s->num_variables; i++) {
+            if (s->values[i] == 0) s->saved_phases[i] = w.best[i];
+        }
+    }
+    free_walker(&w);
+    return found;
+}
+
+// ONLY THE LOCAL SEARCH, UNTIL IT FINDS A MODEL. IT CAN'T SHOW THAT THERE IS
+// NONE, ONLY A CONFLICT ON LEVEL 0 DOES. RETURNS 1 FOR SAT, 0 FOR UNSAT
+int solve_local_search(solver* s) {
+    if (s->inconsistent || !assign_units(s) ||
+            propagate(s, 0) != NO_CONFLICT) {
+        s->inconsistent = 1;
+        return 0;
+    }
+
+    // A MODEL OF THE CLAUSES MAY BE NONE OF THE XORS FROM THE INPUT, THE
+    // LOCAL SEARCH CAN'T WORK ON THOSE
+    int* xors = s->xors.clause_refs;
+    for (int i = 0; i < s->xors.size; i += 2 + xors[i]) {
+        if (!(xors[i + 1] & XOR_RECOVERED)) return decide(s);
+    }
+    return walk(s, LLONG_MAX);
+}
+
+// SET UP THE WALKER FOR THE IRREDUNDANT CLAUSES NOT SATISFIED ON LEVEL 0,
+// WITHOUT THEIR FALSE LITERALS. THE VARIABLES START WITH THEIR SAVED PHASES
+void start_walk(solver* s, walker* w) {
+    int num_lists = 2 * (s->num_variables + 1);
+    w->occurrence_starts = (calloc(num_lists + 1, sizeof(int)));
+
+    // COUNT THE CLAUSES AND THE OCCURRENCES OF EACH LITERAL
+    int num_clauses = 0;
+    int num_literals = 0;
+    int max_size = 0;
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->deleted || c->learned) continue;
+        int size = 0;
+        int satisfied = 0;
+        for (int i = 0; i < c->size && !satisfied; i++) {
+            satisfied = s->values[c->literals[i]] > 0;
+            size += s->values[c->literals[i]] == 0;
+        }
+        if (satisfied) continue;
+        for (int i = 0; i < c->size; i++) {
+            if (s->values[c->literals[i]] == 0) {
+                w->occurrence_starts[WATCH_INDEX(c->literals[i]) + 1]++;
+            }
+        }
+        num_clauses++;
+        num_literals += size;
+        if (size > max_size) max_size = size;
+    }
+    for (int i = 0; i < num_lists; i++) {
+        w->occurrence_starts[i + 1] += w->occurrence_starts[i];
+    }
+
+    w->num_clauses = num_clauses;
+    w->clause_starts = (malloc(sizeof(int) * (num_clauses + 1)));
+    w->literals = (malloc(sizeof(int) * (num_literals + 1)));
+    w->occurrences = (malloc(sizeof(int) * (num_literals + 1)));
+    int* next_occurrence = (malloc(sizeof(int) * (num_lists + 1)));
+    memcpy(next_occurrence, w->occurrence_starts, sizeof(int) * num_lists);
+
+    int clause_index = 0;
+    int literal_count = 0;
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->deleted || c->learned) continue;
+        int satisfied = 0;
+        for (int i = 0; i < c->size && !satisfied; i++) {
+            satisfied = s->values[c->literals[i]] > 0;
+        }
+        if (satisfied) continue;
+
+        w->clause_starts[clause_index] = literal_count;
+        for (int i = 0; i < c->size; i++) {
+            int literal = c->literals[i];
+            if (s->values[literal] != 0) continue;
+            w->literals[literal_count] = literal;
+            literal_count++;
+            w->occurrences[next_occurrence[WATCH_INDEX(literal)]] =
+                clause_index;
+            next_occurrence[WATCH_INDEX(literal)]++;
+        }
+        clause_index++;
+    }
+    w->clause_starts[num_clauses] = literal_count;
+    free(next_occurrence);
+
+    w->values = (malloc(s->num_variables + 1));
+    memcpy(w->values, s->saved_phases, s->num_variables + 1);
+    w->best = (malloc(s->num_variables + 1));
+    memcpy(w->best, w->values, s->num_variables + 1);
+    w->unsaved = (malloc(sizeof(int) * (s->num_variables + 1)));
+    w->unsaved_positions = (malloc(sizeof(int) * (s->num_variables + 1)));
+    memset(w->unsaved_positions, -1, sizeof(int) * (s->num_variables + 1));
+    w->unsaved_count = 0;
+
+    w->true_counts = (calloc(num_clauses + 1, sizeof(int)));
+    w->true_variables = (calloc(num_clauses + 1, sizeof(int)));
+    w->breaks = (calloc(s->num_variables + 1, sizeof(int)));
+    w->false_clauses = (malloc(sizeof(int) * (num_clauses + 1)));
+    w->false_positions = (malloc(sizeof(int) * (num_clauses + 1)));
+    w->false_count = 0;
+    for (int i = 0; i < num_clauses; i++) {
+        for (int j = w->clause_starts[i]; j < w->clause_starts[i + 1]; j++) {
+            int literal = w->literals[j];
+            if (w->values[abs(literal)] == (literal > 0)) {
+                w->true_counts[i]++;
+                w->true_variables[i] ^= abs(literal);
+            }
+        }
+        if (w->true_counts[i] == 1) w->breaks[w->true_variables[i]]++;
+        if (w->true_counts[i] == 0) {
+            w->false_positions[i] = w->false_count;
+            w->false_clauses[w->false_count] = i;
+            w->false_count++;
+        }
+    }
+    w->best_false = w->false_count;
+
+    // THE BREAK FUNCTIONS OF PROBSAT: POLYNOMIAL FOR CLAUSES OF UP TO 3
+    // LITERALS (WITH AN EXPONENT OF 2 INSTEAD OF 2.06), EXPONENTIAL FOR
+    // LONGER ONES, THE BASE GROWING WITH THE LENGTH
+    double base = max_size <= 4 ? 3.0 : max_size == 5 ? 3.7 :
+        max_size == 6 ? 5.1 : 5.4;
+    double power = 1;
+    for (int i = 0; i < WALK_BREAK_LIMIT; i++) {
+        w->probabilities[i] =
+            max_size <= 3 ? 1 / ((0.9 + i) * (0.9 + i)) : power;
+        power /= base;
+    }
+}
+
+// FLIP THE VARIABLE AND UPDATE THE COUNTS OF THE CLAUSES IT IS IN
+void walk_flip(walker* w, int variable_id) {
+    w->values[variable_id] ^= 1;
+    int made_true = w->values[variable_id] ? variable_id : -variable_id;
+
+    int index = WATCH_INDEX(made_true);
+    for (int i = w->occurrence_starts[index];
+            i < w->occurrence_starts[index + 1]; i++) {
+        int clause_index = w->occurrences[i];
+        w->true_counts[clause_index]++;
+        if (w->true_counts[clause_index] == 1) {
+            int last = w->false_clauses[w->false_count - 1];
+            int position = w->false_positions[clause_index];
+            w->false_clauses[position] = last;
+            w->false_positions[last] = position;
+            w->false_count--;
+            w->breaks[variable_id]++;
+        }
+        else if (w->true_counts[clause_index] == 2) {
+            w->breaks[w->true_variables[clause_index]]--;
+        }
+        w->true_variables[clause_index] ^= variable_id;
+    }
+
+    index = WATCH_INDEX(-made_true);
+    for (int i = w->occurrence_starts[index];
+            i < w->occurrence_starts[index + 1]; i++) {
+        int clause_index = w->occurrences[i];
+        w->true_counts[clause_index]--;
+        w->true_variables[clause_index] ^= variable_id;
+        if (w->true_counts[clause_index] == 0) {
+            w->false_positions[clause_index] = w->false_count;
+            w->false_clauses[w->false_count] = clause_index;
+            w->false_count++;
+            w->breaks[variable_id]--;
+        }
+        else if (w->true_counts[clause_index] == 1) {
+            w->breaks[w->true_variables[clause_index]]++;
+        }
+    }
+
+    // THE VARIABLE NOW DIFFERS FROM best, OR NO LONGER DOES
+    int position = w->unsaved_positions[variable_id];
+    if (position < 0) {
+        w->unsaved_positions[variable_id] = w->unsaved_count;
+        w->unsaved[w->unsaved_count] = variable_id;
+        w->unsaved_count++;
+    }
+    else {
+        int last = w->unsaved[w->unsaved_count - 1];
+        w->unsaved[position] = last;
+        w->unsaved_positions[last] = position;
+        w->unsaved_positions[variable_id] = -1;
+        w->unsaved_count--;
+    }
+}
+
+// PICK A VARIABLE OF THE FALSE CLAUSE TO FLIP, EACH WITH THE PROBABILITY OF
+// ITS BREAK COUNT (RELATIVE TO THE OTHERS)
+int walk_pick(walker* w, int clause_index, unsigned long long* random) {
+    int start = w->clause_starts[clause_index];
+    int end = w->clause_starts[clause_index + 1];
+    double sum = 0;
+    for (int i = start; i < end; i++) {
+        int breaks = w->breaks[abs(w->literals[i])];
+        if (breaks >= WALK_BREAK_LIMIT) breaks = WALK_BREAK_LIMIT - 1;
+        sum += w->probabilities[breaks];
+    }
+
+    double threshold = sum * (xorshift(random) / 4294967296.0);
+    for (int i = start; i < end - 1; i++) {
+        int breaks = w->breaks[abs(w->literals[i])];
+        if (breaks >= WALK_BREAK_LIMIT) breaks = WALK_BREAK_LIMIT - 1;
+        threshold -= w->probabilities[breaks];
+        if (threshold < 0) return abs(w->literals[i]);
+    }
+    return abs(w->literals[end - 1]);
+}
+
+// THE CURRENT ASSIGNMENT IS THE BEST SO FAR. ONLY THE VARIABLES FLIPPED
+// SINCE THE LAST BEST ONE ARE COPIED
+void save_best_walk(walker* w) {
+    for (int i = 0; i < w->unsaved_count; i++) {
+        int variable_id = w->unsaved[i];
+        w->best[variable_id] = w->values[variable_id];
+        w->unsaved_positions[variable_id] = -1;
+    }
+    w->unsaved_count = 0;
+    w->best_false = w->false_count;
+}
+
+// ASSIGN THE MODEL OF THE LOCAL SEARCH ON LEVEL 1, AS IF ALL THE VARIABLES
+// WERE DECIDED THERE, SO THAT backtrack_to_root() CAN UNDO IT
+void take_walk_model(solver* s, walker* w) {
+    s->level_starts[1] = s->trail_size;
+    for (int i = 1; i <= s->num_variables; i++) {
+        if (s->values[i] != 0) continue;
+        if (s->eliminated != NULL && s->eliminated[i]) continue;
+        s->antecedents[i] = -1;
+        assign(s, i, 1, w->values[i]);
+    }
+}
+
+void free_walker(walker* w) {
+    free(w->clause_starts);
+    free(w->literals);
+    free(w->occurrence_starts);
+    free(w->occurrences);
+    free(w->values);
+    free(w->best);
+    free(w->unsaved);
+    free(w->unsaved_positions);
+    free(w->true_counts);
+    free(w->true_variables);
+    free(w->breaks);
+    free(w->false_clauses);
+    free(w->false_positions);
+}
+
+// ---PORTFOLIO---
+// SEVERAL SOLVERS SEARCH THE SAME PREPROCESSED FORMULA IN PARALLEL THREADS,
+// EACH WITH DIFFERENT PARAMETERS. THE FIRST ONE TO FINISH DECIDES, THE OTHERS
+// NOTICE THE stop FLAG AND GIVE UP. GOOD LEARNED CLAUSES ARE EXCHANGED
+// WITHOUT LOCKS: EACH SOLVER WRITES ONLY ITS OWN EXPORT BUFFER, THE OTHERS
+// READ IT, AND A READER THAT WAS OVERTAKEN BY THE WRITER DROPS WHAT IT READ
+
+unsigned int next_random(solver* s) {
+    return xorshift(&s->random_state);
+}
+
+// xorshift64*, THE STATE MUST NOT BE 0
+unsigned int xorshift(unsigned long long* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (unsigned int)((*state * 2685821657736338717ULL) >> 32);
+}
+
+// A SOLVER FOR THE SAME FORMULA, WITH THE SAME OPTIONS BUT NOTHING LEARNED.
+// ONLY THE ORIGINAL KEEPS WHAT IS NEEDED FOR MODEL RECONSTRUCTION
+solver* clone_solver(solver* original) {
+    solver* s = new_solver();
+    s->restart_policy = original->restart_policy;
+    s->walking = original->walking;
+    s->num_variables = original->num_variables;
+    for (int i = 0; i < original->xors.size; i++) {
+        push_int(&s->xors, original->xors.clause_refs[i]);
+    }
+    s->num_xors = original->num_xors;
+    s->num_clauses = original->num_clauses;
+
+    s->arena_size = original->arena_size;
+    s->arena_capacity = original->arena_size;
+    s->arena = (malloc(sizeof(int) * s->arena_capacity));
+    memcpy(s->arena, original->arena, sizeof(int) * s->arena_size);
+
+    if (original->eliminated != NULL) {
+        s->eliminated = (malloc(s->num_variables + 1));
+        memcpy(s->eliminated, original->eliminated, s->num_variables + 1);
+    }
+    return s;
+}
+
+// SOLVER 0 KEEPS THE OPTIONS IT WAS GIVEN, THE OTHERS VARY THE RESTART
+// POLICY, VSIDS DECAY, INITIAL PHASES AND (THROUGH RANDOM INITIAL
+// ACTIVITIES) THE ORDER OF THE FIRST DECISIONS
+void diversify(solver* s, int id) {
+    static const double decays[] = {0.95, 0.90, 0.85, 0.97, 0.92, 0.80};
+    if (id == 0) return;
+
+    s->restart_policy = id % 2 ? RESTART_LUBY : RESTART_GLUCOSE;
+    s->vsids_decay = decays[id % 6];
+    s->initial_phase = id % 3 == 2 ? PHASE_RANDOM : id % 3;
+    s->random_state = 0x9e3779b97f4a7c15ULL * (id + 1);
+}
+
+// THE SOLVER HAS THE ANSWER, UNLESS SOMEONE WAS FASTER. STOP THE OTHERS
+void report_answer(solver* s, int result) {
+    int no_winner = -1;
+    if (__atomic_compare_exchange_n(&s->shared->winner, &no_winner, s->id,
+                0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        s->shared->result = result;
+    }
+    __atomic_store_n(&s->shared->stop, 1, __ATOMIC_RELEASE);
+}
+
+void* portfolio_worker(void* argument) {
+    solver* s = argument;
+    int result = decide(s);
+    if (result != SEARCH_STOPPED) report_answer(s, result);
+    return NULL;
+}
+
+// MAKE A PORTFOLIO OF num_solvers SOLVERS, s BEING THE FIRST OF THEM AND THE
+// OTHERS ITS CLONES, DIVERSIFIED IF diversified IS SET
+void start_portfolio(portfolio* shared, solver* s, int num_solvers,
+        int diversified) {
+    shared->solvers = (malloc(sizeof(solver*) * num_solvers));
+    shared->num_solvers = num_solvers;
+    shared->stop = 0;
+    shared->winner = -1;
+    shared->result = 0;
+    shared->cubes = NULL;
+
+    for (int id = 0; id < num_solvers; id++) {
+        solver* member = s;
+        if (id > 0) {
+            member = clone_solver(s);
+            if (diversified) diversify(member, id);
+            init_search(member);
+        }
+        member->shared = shared;
+        member->id = id;
+        member->export_buffer = (malloc(sizeof(int) * EXPORT_BUFFER_SIZE));
+        member->import_positions = (calloc(num_solvers, sizeof(long long)));
+        member->import_buffer = (malloc(sizeof(int) * EXPORT_BUFFER_SIZE));
+        shared->solvers[id] = member;
+    }
+}
+
+// RUN worker ON EVERY SOLVER OF THE PORTFOLIO, EACH IN ITS OWN THREAD,
+// AND WAIT UNTIL ALL OF THEM ARE DONE
+void run_portfolio(portfolio* shared, void* (*worker)(void*)) {
+    int num_solvers = shared->num_solvers;
+    pthread_t* threads = (malloc(sizeof(pthread_t) * num_solvers));
+    int started = 0;
+    while (started < num_solvers && pthread_create(threads + started, NULL,
+                worker, shared->solvers[started]) == 0) {
+        started++;
+    }
+
+    // WITHOUT A SINGLE THREAD NOBODY WOULD SOLVE IT, FALL BACK TO SEARCHING
+    // HERE. IF ONLY SOME FAILED TO START, THE OTHERS ARE ENOUGH
+    if (started == 0) worker(shared->solvers[0]);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    free(threads);
+}
+
+// AFTER THE RUN, GIVE THE FIRST SOLVER THE MODEL OF THE WINNER AND THE
+// COUNTERS OF ALL THE SOLVERS, AND FREE THE OTHERS.
+// RETURNS 1 FOR SAT, 0 FOR UNSAT
+int finish_portfolio(portfolio* shared) {
+    solver* s = shared->solvers[0];
+    if (shared->winner > 0 && shared->result) {
+        solver* winner = shared->solvers[shared->winner];
+        memcpy(s->values - s->num_variables,
+                winner->values - s->num_variables, 2 * s->num_variables + 1);
+    }
+
+    for (int id = 1; id < shared->num_solvers; id++) {
+        solver* member = shared->solvers[id];
+        s->num_learned += member->num_learned;
+        s->num_deleted += member->num_deleted;
+        s->num_branching += member->num_branching;
+        s->num_restarts += member->num_restarts;
+        s->num_imported += member->num_imported;
+        s->num_propagations += member->num_propagations;
+        s->num_conflicts += member->num_conflicts;
+        s->lbd_total_sum += member->lbd_total_sum;
+        s->propagate_seconds += member->propagate_seconds;
+        s->analyze_seconds += member->analyze_seconds;
+        free_solver(member);
+    }
+    free(shared->solvers);
+    s->shared = NULL;
+    return shared->result;
+}
+
+// SOLVE WITH num_threads DIFFERENTLY CONFIGURED SOLVERS, s BEING THE FIRST
+// OF THEM. RETURNS 1 FOR SAT, 0 FOR UNSAT
+int solve_portfolio(solver* s, int num_threads) {
+    portfolio shared;
+    start_portfolio(&shared, s, num_threads, 1);
+    run_portfolio(&shared, portfolio_worker);
+    return finish_portfolio(&shared);
+}
+
+// APPEND THE CLAUSE TO THIS SOLVER'S EXPORT BUFFER. THE FENCE KEEPS THE
+// NEW WORDS FROM BECOMING VISIBLE BEFORE THE PREVIOUS HEAD, WHICH IS WHAT
+// LETS READERS DETECT THAT THEY WERE OVERTAKEN
+void export_clause(solver* s, int* literals, int size, int lbd) {
+    long long head = s->export_head;
+    int* buffer = s->export_buffer;
+
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(buffer + (head & (EXPORT_BUFFER_SIZE - 1)), size,
+            __ATOMIC_RELAXED);
+    __atomic_store_n(buffer + ((head + 1) & (EXPORT_BUFFER_SIZE - 1)), lbd,
+            __ATOMIC_RELAXED);
+    for (int i = 0; i < size; i++) {
+        __atomic_store_n(buffer + ((head + 2 + i) & (EXPORT_BUFFER_SIZE - 1)),
+                literals[i], __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&s->export_head, head + size + 2, __ATOMIC_RELEASE);
+}
+
+// ADD A CLAUSE FROM ANOTHER SOLVER ON LEVEL 0, WITHOUT ITS FALSE LITERALS.
+// RETURNS 0 IF IT IS FALSE, WHICH MAKES THE FORMULA UNSAT
+int add_imported_clause(solver* s, int* literals, int size, int lbd) {
+    int kept = 0;
+    for (int i = 0; i < size; i++) {
+        if (s->values[literals[i]] > 0) return 1;
+        if (s->values[literals[i]] == 0) {
+            literals[kept] = literals[i];
+            kept++;
+        }
+    }
+
+    s->num_imported++;
+    if (kept == 0) return 0;
+    if (kept == 1) {
+        assign(s, abs(literals[0]), 0, literals[0] > 0);
+        return 1;
+    }
+
+    int clause_ref = allocate_clause(s, kept);
+    remember_learned(s, clause_ref);
+    clause* imported = CLAUSE(clause_ref);
+    imported->learned = 1;
+    imported->lbd = lbd < kept ? lbd : kept;
+    memcpy(imported->literals, literals, sizeof(int) * kept);
+    attach_clause(s, clause_ref);
+    return 1;
+}
+
+// TAKE THE NEW CLAUSES FROM ALL THE OTHER SOLVERS' EXPORT BUFFERS.
+// THEY ARE COPIED FIRST, AND ONLY USED IF THE WRITER DIDN'T GET CLOSE ENOUGH
+// TO OVERWRITING THEM IN THE MEANTIME. MUST BE CALLED ON LEVEL 0.
+// RETURNS 0 IF THE FORMULA TURNED OUT UNSAT
+int import_clauses(solver* s) {
+    portfolio* shared = s->shared;
+
+    for (int other_id = 0; other_id < shared->num_solvers; other_id++) {
+        if (other_id == s->id) continue;
+        solver* other = shared->solvers[other_id];
+        long long position = s->import_positions[other_id];
+        long long head = __atomic_load_n(&other->export_head,
+                __ATOMIC_ACQUIRE);
+        s->import_positions[other_id] = head;
+
+        // FELL TOO FAR BEHIND, THE UNREAD CLAUSES ARE LOST
+        if (head - position > EXPORT_BUFFER_SIZE - SHARE_MAX_WORDS) continue;
+
+        int words = head - position;
+        for (int i = 0; i < words; i++) {
+            s->import_buffer[i] = __atomic_load_n(other->export_buffer +
+                    ((position + i) & (EXPORT_BUFFER_SIZE - 1)),
+                    __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        long long new_head = __atomic_load_n(&other->export_head,
+                __ATOMIC_RELAXED);
+        if (new_head + SHARE_MAX_WORDS > position + EXPORT_BUFFER_SIZE) {
+            continue;
+        }
+
+        for (int i = 0; i < words; i += s->import_buffer[i] + 2) {
+            if (!add_imported_clause(s, s->import_buffer + i + 2,
+                        s->import_buffer[i], s->import_buffer[i + 1])) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ---CUBE AND CONQUER---
+// A LOOKAHEAD SPLITS THE FORMULA INTO CUBES (PARTIAL ASSIGNMENTS), THEN A POOL
+// OF WORKERS SOLVES THE FORMULA UNDER EACH CUBE AS ASSUMPTIONS. A WORKER
+// KEEPS ITS LEARNED CLAUSES FROM CUBE TO CUBE AND SHARES THEM LIKE A
+// PORTFOLIO DOES. THE FORMULA IS UNSAT IF EVERY CUBE IS
+
+// PICK THE VARIABLE TO SPLIT ON AFTER level DECISIONS: EVERY CANDIDATE IS SET
+// BOTH WAYS, THE ONE WHERE BOTH SIDES PROPAGATE THE MOST (THE PRODUCT OF
+// THE NUMBERS OF ASSIGNED VARIABLES) WINS. IF ONE SIDE FAILS, ONLY ONE BRANCH
+// IS LEFT, SUCH A VARIABLE IS TAKEN RIGHT AWAY.
+// RETURNS 0 IF NOTHING IS LEFT TO SPLIT ON, -1 IF BOTH SIDES OF SOME
+// VARIABLE FAIL, WHICH REFUTES THE CURRENT DECISIONS
+int lookahead(solver* s, int* order, int level) {
+    int best = 0;
+    long long best_score = -1;
+    int tried = 0;
+
+    for (int i = 0; i < s->num_variables && tried < CUBE_CANDIDATES; i++) {
+        int variable_id = order[i];
+        if (s->values[variable_id] != 0 ||
+                (s->eliminated != NULL && s->eliminated[variable_id])) {
+            continue;
+        }
+        tried++;
+
+        int implied[2];
+        for (int value = 0; value < 2; value++) {
+            s->level_starts[level + 1] = s->trail_size;
+            assign(s, variable_id, level + 1, value);
+            implied[value] = propagate(s, level + 1) != NO_CONFLICT ? -1 :
+                s->trail_size - s->level_starts[level + 1];
+            backtrack(s, level);
+        }
+
+        if (implied[0] < 0 && implied[1] < 0) return -1;
+        if (implied[0] < 0 || implied[1] < 0) return variable_id;
+        long long score = (long long)implied[0] * implied[1];
+        if (score > best_score) {
+            best = variable_id;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+// SPLIT THE FORMULA UNDER THE CURRENT level DECISIONS depth MORE TIMES.
+// BRANCHES THAT FAIL IN PROPAGATION ARE DROPPED, THE OTHERS GO TO THE POOL
+// AS THE DECISIONS LEADING TO THEM (THE FIRST LITERAL OF EACH LEVEL)
+void split_cubes(solver* s, cube_pool* pool, int* order, int level,
+        int depth) {
+    int branch = depth > 0 ? lookahead(s, order, level) : 0;
+    if (branch < 0) return;
+
+    if (branch == 0) {
+        push_int(&pool->starts, pool->literals.size);
+        for (int k = 1; k <= level; k++) {
+            push_int(&pool->literals, s->trail[s->level_starts[k]]);
+        }
+        return;
+    }
+
+    for (int value = 1; value >= 0; value--) {
+        s->level_starts[level + 1] = s->trail_size;
+        assign(s, branch, level + 1, value);
+        if (propagate(s, level + 1) == NO_CONFLICT) {
+            split_cubes(s, pool, order, level + 1, depth - 1);
+        }
+        backtrack(s, level);
+    }
+}
+
+// NEXT CUBE FOR WORKER id: FROM ITS OWN RANGE, OR ELSE FROM THE BACK HALF
+// OF ANOTHER WORKER'S RANGE, WHICH BECOMES ITS OWN.
+// RETURNS -1 WHEN NO CUBES ARE LEFT
+int take_cube(cube_pool* pool, int id, int num_workers) {
+    pthread_mutex_lock(pool->locks + id);
+    int cube = -1;
+    if (pool->next[id] < pool->end[id]) {
+        cube = pool->next[id];
+        pool->next[id]++;
+    }
+    pthread_mutex_unlock(pool->locks + id);
+
+    for (int i = 1; cube < 0 && i < num_workers; i++) {
+        int victim = (id + i) % num_workers;
+        pthread_mutex_lock(pool->locks + victim);
+        int left = pool->end[victim] - pool->next[victim];
+        int stolen_end = pool->end[victim];
+        int stolen_start = stolen_end - (left + 1) / 2;
+        if (left > 0) pool->end[victim] = stolen_start;
+        pthread_mutex_unlock(pool->locks + victim);
+
+        if (left > 0) {
+            cube = stolen_start;
+            pthread_mutex_lock(pool->locks + id);
+            pool->next[id] = stolen_start + 1;
+            pool->end[id] = stolen_end;
+            pthread_mutex_unlock(pool->locks + id);
+        }
+    }
+    return cube;
+}
+
+void* cube_worker(void* argument) {
+    solver* s = argument;
+    cube_pool* pool = s->shared->cubes;
+
+    int cube;
+    while ((cube = take_cube(pool, s->id, s->shared->num_solvers)) >= 0) {
+        int start = pool->starts.clause_refs[cube];
+        s->assumptions = pool->literals.clause_refs + start;
+        s->assumption_count = pool->starts.clause_refs[cube + 1] - start;
+
+        double cube_start = seconds_now();
+        int result = decide(s);
+        s->assumptions = NULL;
+        s->assumption_count = 0;
+        if (result == SEARCH_STOPPED) break;
+
+        int done = __atomic_add_fetch(&pool->done, 1, __ATOMIC_RELAXED);
+        printf("c cube %d: %s in %.2fs by worker %d, %d of %d done\n",
+                cube, result ? "SAT" : "UNSAT", seconds_now() - cube_start,
+                s->id, done, pool->count);
+        if (result) {
+            report_answer(s, 1);
+            break;
+        }
+    }
+    return NULL;
+}
+
+// CUBE AND CONQUER WITH ABOUT num_cubes CUBES AND num_threads WORKERS, s
+// BEING THE FIRST OF THEM. RETURNS 1 FOR SAT, 0 FOR UNSAT
+int solve_cubes(solver* s, int num_threads, int num_cubes) {
+    if (!assign_units(s) || propagate(s, 0) != NO_CONFLICT) return 0;
+
+    int depth = 0;
+    while ((1 << depth) < num_cubes && depth < 30) depth++;
+
+    // LOOKAHEAD CANDIDATES ARE THE VARIABLES WITH THE MOST OCCURRENCES
+    sort_entry* entries = (calloc(s->num_variables + 1, sizeof(sort_entry)));
+    for (int ref = 0; ref < s->arena_size; ref = NEXT_CLAUSE(ref)) {
+        clause* c = CLAUSE(ref);
+        if (c->deleted) continue;
+        for (int i = 0; i < c->size; i++) {
+            entries[abs(c->literals[i])].primary--;
+        }
+    }
+    for (int i = 1; i <= s->num_variables; i++) entries[i].value = i;
+    qsort(entries + 1, s->num_variables, sizeof(sort_entry), compare_entries);
+    int* order = (malloc(sizeof(int) * s->num_variables));
+    for (int i = 0; i < s->num_variables; i++) order[i] = entries[i + 1].value;
+    free(entries);
+
+    cube_pool pool = {{NULL, 0, 0}, {NULL, 0, 0}, 0, NULL, NULL, NULL, 0};
+    double split_start = seconds_now();
+    split_cubes(s, &pool, order, 0, depth);
+    push_int(&pool.starts, pool.literals.size);
+    pool.count = pool.starts.size - 1;
+    free(order);
+    printf("c cubes: %d in %.2fs\n", pool.count, seconds_now() - split_start);
+
+    // EVERY BRANCH FAILED, THE FORMULA IS UNSAT
+    int result = 0;
+    if (pool.count > 0) {
+        portfolio shared;
+        start_portfolio(&shared, s, num_threads, 0);
+        shared.cubes = &pool;
+
+        pool.next = (malloc(sizeof(int) * num_threads));
+        pool.end = (malloc(sizeof(int) * num_threads));
+        pool.locks = (malloc(sizeof(pthread_mutex_t) * num_threads));
+        for (int w = 0; w < num_threads; w++) {
+            pool.next[w] = (long long)pool.count * w / num_threads;
+            pool.end[w] = (long long)pool.count * (w + 1) / num_threads;
+            pthread_mutex_init(pool.locks + w, NULL);
+        }
+
+        run_portfolio(&shared, cube_worker);
+        result = finish_portfolio(&shared);
+
+        for (int w = 0; w < num_threads; w++) {
+            pthread_mutex_destroy(pool.locks + w);
+        }
+        free(pool.next);
+        free(pool.end);
+        free(pool.locks);
+    }
+    free(pool.literals.clause_refs);
+    free(pool.starts.clause_refs);
+    return result;
+}
+
+// ---BATCH---
+// MANY SMALL FORMULAS, EACH IN ITS OWN FILE, SOLVED BY A POOL OF WORKER
+// THREADS. EVERY WORKER HAS ONE SOLVER, WHICH IT RESETS FOR EACH FILE IT
+// TAKES, SO THE MEMORY OF ONE FORMULA IS REUSED FOR THE NEXT
+
+// ADD THE FILE path TO THE BATCH, ALL THE CNF FILES (POSSIBLY COMPRESSED)
+// IN IT IN NAME ORDER IF IT IS A DIRECTORY, OR THE PATHS READ FROM STANDARD
+// INPUT, ONE PER LINE, IF IT IS "-". RETURNS 0 IF IT CAN'T BE READ
+int add_batch_input(batch* b, const char* path) {
+    if (!strcmp(path, "-")) {
+        char* line = NULL;
+        size_t line_capacity = 0;
+        ssize_t length;
+        while ((length = getline(&line, &line_capacity, stdin)) > 0) {
+            while (length > 0 && (line[length - 1] == '\n' ||
+                        line[length - 1] == '\r')) {
+                length--;
+            }
+            line[length] = '\0';
+            if (length > 0) add_batch_path(b, line);
+        }
+        free(line);
+        return 1;
+    }
+
+    struct stat info;
+    if (stat(path, &info) < 0) {
+        fprintf(stderr, "file not found: %s\n", path);
+        return 0;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        add_batch_path(b, path);
+        return 1;
+    }
+
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+        fprintf(stderr, "can't open directory: %s\n", path);
+        return 0;
+    }
+    int first = b->count;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strstr(entry->d_name, ".cnf") == NULL) continue;
+        char* file_path = (malloc(strlen(path) + strlen(entry->d_name) + 2));
+        sprintf(file_path, "%s/%s", path, entry->d_name);
+        add_batch_path(b, file_path);
+        free(file_path);
+    }
+    closedir(dir);
+    qsort(b->paths + first, b->count - first, sizeof(char*), compare_paths);
+    return 1;
+}
+
+void add_batch_path(batch* b, const char* path) {
+    if (b->count == b->capacity) {
+        b->capacity = b->capacity == 0 ? 64 : 2 * b->capacity;
+        b->paths = (realloc(b->paths, sizeof(char*) * b->capacity));
+    }
+    b->paths[b->count] = (malloc(strlen(path) + 1));
+    strcpy(b->paths[b->count], path);
+    b->count++;
+}
+
+int compare_paths(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// SOLVE FILE index WITH THE WORKER'S SOLVER AND WRITE ITS .sat FILE
+void solve_batch_file(batch* b, solver* s, int index) {
+    const char* cnf_path = b->paths[index];
+    reset_solver(s);
+    b->answers[index] = BATCH_ERROR;
+
+    s->num_clauses = parse_cnf(s, cnf_path);
+    if (s->num_clauses >= 0) {
+        if (s->xor_recovery) recover_xors(s);
+        int sat = b->use_preprocessing ? preprocess(s) : 1;
+        init_search(s);
+        if (sat) sat = decide(s);
+        if (sat && s->eliminated != NULL) reconstruct_model(s);
+
+        char* solution_path = solution_filename(cnf_path);
+        if (write_solution(s, solution_path, sat)) b->answers[index] = sat;
+        free(solution_path);
+    }
+    b->seconds[index] = seconds_now() - s->start_time;
+    b->conflicts[index] = s->num_conflicts;
+}
+
+// TAKE FILES UNTIL THERE ARE NONE LEFT
+void* batch_worker(void* argument) {
+    batch* b = argument;
+    solver* s = new_solver();
+    s->restart_policy = b->options->restart_policy;
+    s->inprocessing = b->options->inprocessing;
+    s->walking = b->options->walking;
+    s->xor_recovery = b->options->xor_recovery;
+
+    int index;
+    while ((index = __atomic_fetch_add(&b->next, 1, __ATOMIC_RELAXED)) <
+            b->count) {
+        solve_batch_file(b, s, index);
+    }
+    free_solver(s);
+    return NULL;
+}
+
+// SOLVE ALL THE FILES OF THE BATCH WITH num_threads WORKERS, WHOSE SOLVERS
+// GET THE OPTIONS OF options, AND PRINT A TABLE OF THE RESULTS IN THE ORDER
+// OF THE FILES. RETURNS THE NUMBER OF FILES THAT COULDN'T BE SOLVED
+int solve_batch(batch* b, const solver* options, int num_threads,
+        int use_preprocessing) {
+    double start = seconds_now();
+    b->options = options;
+    b->use_preprocessing = use_preprocessing;
+    b->next = 0;
+    b->answers = (malloc(sizeof(int) * (b->count + 1)));
+    b->seconds = (malloc(sizeof(double) * (b->count + 1)));
+    b->conflicts = (malloc(sizeof(long long) * (b->count + 1)));
+
+    // AS IN run_portfolio(), IF NO THREAD STARTS THE WORK IS DONE HERE
+    if (num_threads > b->count) num_threads = b->count;
+    pthread_t* threads = (malloc(sizeof(pthread_t) * (num_threads + 1)));
+    int started = 0;
+    while (started < num_threads && pthread_create(threads + started, NULL,
+                batch_worker, b) == 0) {
+        started++;
+    }
+    if (started == 0) batch_worker(b);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    free(threads);
+
+    static const char* answers[] = {"UNSATISFIABLE", "SATISFIABLE"};
+    int counts[3] = {0, 0, 0};
+    for (int i = 0; i < b->count; i++) {
+        int answer = b->answers[i];
+        counts[answer + 1]++;
+        printf("%-40s %-14s %8.3fs %10lld conflicts\n", b->paths[i],
+                answer == BATCH_ERROR ? "ERROR" : answers[answer],
+                b->seconds[i], b->conflicts[i]);
+    }
+    printf("%d files: %d satisfiable, %d unsatisfiable, %d errors, "
+            "%.3f seconds\n", b->count, counts[2], counts[1], counts[0],
+            seconds_now() - start);
+
+    free(b->answers);
+    free(b->seconds);
+    free(b->conflicts);
+    return counts[0];
+}
+
+void free_batch(batch* b) {
+    for (int i = 0; i < b->count; i++) free(b->paths[i]);
+    free(b->paths);
+}
+
+// ---STATISTICS---
+
+double seconds_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// CALLED EVERY PROGRESS_CHECK CONFLICTS, PRINTS A PROGRESS REPORT IF ONE IS
+// DUE. IN A PORTFOLIO ONLY THE FIRST SOLVER REPORTS, ITS OWN COUNTERS
+void check_progress(solver* s) {
+    s->next_progress_check = s->num_conflicts + PROGRESS_CHECK;
+    if (s->progress_interval <= 0 || s->id != 0) return;
+
+    double elapsed = seconds_now() - s->start_time;
+    if (s->next_progress == 0) s->next_progress = s->progress_interval;
+    if (elapsed < s->next_progress) return;
+
+    print_statistics(s, 0);
+    while (s->next_progress <= elapsed) {
+        s->next_progress += s->progress_interval;
+    }
+}
+
+// PRINT THE COUNTERS, ONE "c name: value" LINE EACH FOR THE FINAL SUMMARY
+// OR ALL ON ONE LINE FOR A PROGRESS REPORT. WITH json_output IT IS A JSON
+// OBJECT ON ONE LINE INSTEAD, THE NAMES WITH UNDERSCORES FOR SPACES.
+// THE TIMES OF A PORTFOLIO ARE THE SUMS OVER ITS THREADS
+void print_statistics(solver* s, int final) {
+    double seconds = seconds_now() - s->start_time;
+    double average_lbd =
+        s->num_learned > 0 ? (double)s->lbd_total_sum / s->num_learned : 0;
+    double speed = seconds > 0 ? s->num_propagations / seconds : 0;
+
+    // THE FIRST progress_count ARE ALSO PART OF THE PROGRESS REPORTS
+    const int progress_count = 11;
+    struct {
+        const char* name;
+        double value;
+        int decimals;
+    } statistics[] = {
+        {"seconds", seconds, 2},
+        {"conflicts", s->num_conflicts, 0},
+        {"decisions", s->num_branching, 0},
+        {"propagations", s->num_propagations, 0},
+        {"propagations per second", speed, 0},
+        {"restarts", s->num_restarts, 0},
+        {"clauses learned", s->num_learned, 0},
+        {"clauses deleted", s->num_deleted, 0},
+        {"average lbd", average_lbd, 2},
+        {"propagate seconds", s->propagate_seconds, 2},
+        {"analyze seconds", s->analyze_seconds, 2},
+        {"parse seconds", s->parse_seconds, 2},
+        {"preprocess seconds", s->preprocess_seconds, 2},
+        {"variables eliminated", s->num_eliminated, 0},
+        {"clauses subsumed", s->num_subsumed, 0},
+        {"clauses strengthened", s->num_strengthened, 0},
+        {"clauses imported", s->num_imported, 0},
+        {"inprocessings", s->num_inprocessings, 0},
+        {"units probed", s->num_probed_units, 0},
+        {"variables substituted", s->num_substituted, 0},
+        {"clauses vivified", s->num_vivified, 0},
+        {"local searches", s->num_walks, 0},
+        {"flips", s->num_flips, 0},
+        {"xor constraints", s->num_xors, 0},
+        {"xor propagations", s->num_xor_propagations, 0},
+        {"xor conflicts", s->num_xor_conflicts, 0},
+    };
+    int count = final ? (int)(sizeof(statistics) / sizeof(statistics[0]))
+        : progress_count;
+
+    if (s->json_output) {
+        printf("{\"type\": \"%s\"", final ? "summary" : "progress");
+    }
+    else if (!final) printf("c progress:");
+
+    for (int i = 0; i < count; i++) {
+        const char* name = statistics[i].name;
+        if (s->json_output) {
+            printf(", \"");
+            for (int j = 0; name[j] != '\0'; j++) {
+                putchar(name[j] == ' ' ? '_' : name[j]);
+            }
+            printf("\": ");
+        }
+        else if (final) printf("c %s: ", name);
+        else printf("%s %s ", i > 0 ? "," : "", name);
+        printf("%.*f", statistics[i].decimals, statistics[i].value);
+        if (final && !s->json_output) printf("\n");
+    }
+
+    if (s->json_output) printf("}\n");
+    else if (!final) printf("\n");
+    fflush(stdout);
+}
+
+// ---PROOF---
+// BINARY DRAT: AN ADDED CLAUSE IS AN 'a', A DELETED ONE A 'd', FOLLOWED BY
+// ITS LITERALS AND A 0 BYTE. A LITERAL l IS WRITTEN AS 2 * |l| + (l < 0),
+// 7 BITS PER BYTE, LOWEST FIRST, THE HIGH BIT SET ON ALL BUT THE LAST BYTE.
+// THE BYTES ARE COLLECTED IN proof_buffer AND WRITTEN PROOF_BUFFER_SIZE AT
+// A TIME. NOTHING IS EVER SEEKED, SO THE PROOF CAN GO TO A PIPE
+
+// START WRITING THE PROOF TO path, "-" IS STANDARD OUTPUT. THE TEXT OUTPUT
+// THEN MOVES TO STANDARD ERROR SO IT DOESN'T GET MIXED INTO THE PROOF.
+// RETURNS 0 IF THE FILE CAN'T BE OPENED
+int open_proof(solver* s, const char* path) {
+    if (!strcmp(path, "-")) {
+        fflush(stdout);
+        s->proof_fd = dup(STDOUT_FILENO);
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+    }
+    else s->proof_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (s->proof_fd < 0) {
+        fprintf(stderr, "can't open proof file: %s\n", path);
+        return 0;
+    }
+    s->proof_buffer = (malloc(PROOF_BUFFER_SIZE));
+    s->proof_size = 0;
+    return 1;
+}
+
+// WRITE OUT THE BUFFER. A PIPE MAY TAKE IT IN PIECES. IF WRITING FAILS THE
+// PROOF IS INCOMPLETE ANYWAY, SO IT IS GIVEN UP
+void flush_proof(solver* s) {
+    int written = 0;
+    while (written < s->proof_size) {
+        ssize_t result = write(s->proof_fd, s->proof_buffer + written,
+                s->proof_size - written);
+        if (result < 0) {
+            fprintf(stderr, "writing the proof failed, it is incomplete\n");
+            free(s->proof_buffer);
+            s->proof_buffer = NULL;
+            return;
+        }
+        written += result;
+    }
+    s->proof_size = 0;
+}
+
+void close_proof(solver* s) {
+    if (s->proof_buffer == NULL) return;
+    flush_proof(s);
+    free(s->proof_buffer);
+    s->proof_buffer = NULL;
+    close(s->proof_fd);
+}
+
+void write_proof(solver* s, unsigned char kind, const int* literals,
+        int size) {
+    if (s->proof_size > PROOF_BUFFER_SIZE - 6) flush_proof(s);
+    if (s->proof_buffer == NULL) return;
+    s->proof_buffer[s->proof_size] = kind;
+    s->proof_size++;
+
+    for (int i = 0; i < size; i++) {
+        if (s->proof_size > PROOF_BUFFER_SIZE - 6) flush_proof(s);
+        if (s->proof_buffer == NULL) return;
+        unsigned int encoded = 2u * abs(literals[i]) + (literals[i] < 0);
+        while (encoded > 127) {
+            s->proof_buffer[s->proof_size] = (encoded & 127) | 128;
+            s->proof_size++;
+            encoded >>= 7;
+        }
+        s->proof_buffer[s->proof_size] = encoded;
+        s->proof_size++;
+    }
+    s->proof_buffer[s->proof_size] = 0;
+    s->proof_size++;
+}
+
+// THE CLAUSE FOLLOWS FROM THE FORMULA AND THE CLAUSES ADDED BEFORE IT
+void proof_add(solver* s, const int* literals, int size) {
+    if (s->proof_buffer != NULL) write_proof(s, 'a', literals, size);
+}
+
+// THE CLAUSE IS NO LONGER USED. UNITS ARE KEPT, THE LEVEL 0 ASSIGNMENTS
+// STILL DEPEND ON THEM
+void proof_delete(solver* s, const int* literals, int size) {
+    if (s->proof_buffer != NULL && size > 1) {
+        write_proof(s, 'd', literals, size);
+    }
+}
+
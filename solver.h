@@ -0,0 +1,695 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <pthread.h>
+
+// --- TYPEDEFS ---
+typedef struct watch_list watch_list;
+typedef struct watcher watcher;
+typedef struct watcher_list watcher_list;
+typedef struct clause clause;
+typedef struct parser_state parser_state;
+typedef struct solver solver;
+typedef struct portfolio portfolio;
+typedef struct cube_pool cube_pool;
+typedef struct sort_entry sort_entry;
+typedef struct batch batch;
+typedef struct walker walker;
+typedef struct gauss gauss;
+
+// --- RETURN VALUES FOR replace_watched() FUNCTION ---
+#define VISIT_CONFLICT 0
+#define VISIT_NORMAL 1
+#define VISIT_RESOLVED 2
+
+// --- WATCH LISTS ARE INDEXED BY LITERAL: 2 * ID FOR POSITIVE, 2 * ID + 1 FOR
+// NEGATIVE ---
+#define WATCH_INDEX(literal) (2 * abs(literal) + ((literal) < 0))
+#define INDEX_LITERAL(index) ((index) / 2 * ((index) % 2 ? -1 : 1))
+
+// --- SIZE OF THE CHUNKS READ FROM A DECOMPRESSOR ---
+#define STREAM_CHUNK (1 << 20)
+
+// --- HOW MUCH BIGGER THAN ITS FILE A COMPRESSED CNF IS ASSUMED TO BE WHEN
+// PREALLOCATING FOR IT ---
+#define COMPRESSION_RATIO 8
+
+// --- RETURNED BY propagate() WHEN ALL CLAUSES ARE FINE ---
+#define NO_CONFLICT -1
+
+// --- RETURNED BY propagate() FOR A CONFLICTING BINARY CLAUSE ---
+#define BINARY_CONFLICT -2
+
+// --- ANTECEDENTS ---
+// A CLAUSE REF, -1 FOR A DECISION, OR FOR A LITERAL IMPLIED BY A BINARY
+// CLAUSE THE OTHER LITERAL OF THE CLAUSE ENCODED BELOW BINARY_CONFLICT
+#define BINARY_ANTECEDENT(literal) (-2 - WATCH_INDEX(literal))
+#define IS_BINARY_ANTECEDENT(antecedent) ((antecedent) < BINARY_CONFLICT)
+#define BINARY_REASON_LITERAL(antecedent) INDEX_LITERAL(-2 - (antecedent))
+
+// --- VSIDS PARAMETERS ---
+// AFTER EVERY CONFLICT THE BUMP GROWS BY 1 / VSIDS_DECAY, WHICH IS THE SAME
+// AS DECAYING ALL ACTIVITIES BY VSIDS_DECAY. ONCE SOME ACTIVITY GETS ABOVE
+// VSIDS_RESCALE_LIMIT, ALL ACTIVITIES AND THE BUMP ARE SCALED DOWN
+#define VSIDS_DECAY 0.95
+#define VSIDS_RESCALE_LIMIT 1e100
+
+// --- LEARNED CLAUSE DATABASE PARAMETERS ---
+// THE DATABASE IS REDUCED AFTER REDUCE_FIRST CONFLICTS, EACH NEXT REDUCTION
+// COMES REDUCE_INCREMENT CONFLICTS LATER THAN THE PREVIOUS ONE.
+// CLAUSES WITH LBD UP TO GLUE_LBD ARE NEVER DELETED.
+// CLAUSE ACTIVITIES DECAY THE SAME WAY AS VARIABLE ONES
+#define REDUCE_FIRST 2000
+#define REDUCE_INCREMENT 300
+#define GLUE_LBD 2
+#define CLAUSE_DECAY 0.999
+#define CLAUSE_RESCALE_LIMIT 1e20
+
+// --- RESTART POLICIES ---
+// LUBY: RESTART AFTER LUBY_UNIT * luby(i) CONFLICTS.
+// GLUCOSE: RESTART WHEN THE AVERAGE LBD OF THE LAST LBD_WINDOW LEARNED
+// CLAUSES IS MUCH WORSE THAN THE AVERAGE OVER THE WHOLE RUN
+#define RESTART_NONE 0
+#define RESTART_LUBY 1
+#define RESTART_GLUCOSE 2
+#define LUBY_UNIT 100
+#define LBD_WINDOW 50
+#define GLUCOSE_MARGIN 0.8
+
+// --- PREPROCESSING LIMITS ---
+// A VARIABLE IS ONLY ELIMINATED IF IT OCCURS IN AT MOST ELIM_OCCURRENCE_LIMIT
+// CLAUSES, NO RESOLVENT IS LONGER THAN ELIM_RESOLVENT_LIMIT AND THERE ARE NO
+// MORE RESOLVENTS THAN CLAUSES REMOVED. PREPROCESSING STOPS AFTER
+// PREPROCESS_ROUNDS ROUNDS OR PREPROCESS_STEP_LIMIT LITERAL VISITS
+#define ELIM_OCCURRENCE_LIMIT 16
+#define ELIM_RESOLVENT_LIMIT 20
+#define PREPROCESS_ROUNDS 3
+#define PREPROCESS_STEP_LIMIT 200000000LL
+
+// --- INPROCESSING ---
+// BETWEEN RESTARTS THE SEARCH PROBES LITERALS AND SUBSTITUTES EQUIVALENT
+// ONES, FIRST AFTER INPROCESS_FIRST CONFLICTS, THEN AFTER INTERVALS GROWING
+// BY INPROCESS_INCREMENT. PROBING MAY PROPAGATE PROBE_EFFORT TIMES AS MANY
+// LITERALS AS THE SEARCH DID SINCE THE LAST TIME, BUT AT LEAST
+// PROBE_MIN_EFFORT. THE VIVIFICATION OF LEARNED CLAUSES MAY TAKE
+// VIVIFY_EFFORT TIMES THE TIME OF THE SEARCH SINCE THE LAST TIME
+#define INPROCESS_FIRST 5000
+#define INPROCESS_INCREMENT 5000
+#define PROBE_EFFORT 0.1
+#define PROBE_MIN_EFFORT 100000
+#define VIVIFY_EFFORT 0.1
+
+// --- LOCAL SEARCH ---
+// PROBSAT: A RANDOM FALSE CLAUSE IS PICKED AND ONE OF ITS VARIABLES FLIPPED,
+// THE MORE CLAUSES THE FLIP WOULD MAKE FALSE (ITS BREAK COUNT) THE LESS
+// LIKELY. BREAK COUNTS FROM WALK_BREAK_LIMIT ON ARE ALL AS UNLIKELY.
+// THE SEARCH RUNS IT FIRST AFTER WALK_FIRST CONFLICTS, THEN AFTER INTERVALS
+// GROWING BY WALK_INCREMENT, FOR WALK_EFFORT FLIPS PER PROPAGATION OF THE
+// SEARCH SINCE THE LAST TIME, BUT AT LEAST WALK_MIN_FLIPS
+#define WALK_FIRST 2000
+#define WALK_INCREMENT 4000
+#define WALK_EFFORT 0.3
+#define WALK_MIN_FLIPS 20000
+#define WALK_BREAK_LIMIT 64
+
+// --- XOR CONSTRAINTS ---
+// CLAUSES OF 3 UP TO XOR_MAX_SIZE LITERALS ARE CHECKED FOR ENCODING AN XOR
+// TOGETHER. XORS SHARING VARIABLES GO INTO ONE GAUSSIAN ELIMINATION MATRIX,
+// A GROUP OF RECOVERED ONES IS ONLY KEPT WITH 2 UP TO GAUSS_MAX_ROWS XORS.
+// A MATRIX KEEPS A COPY FOR EVERY DECISION LEVEL THAT CHANGED IT, AT MOST
+// GAUSS_MAX_COPIES (THE LAST ONE IS THEN CHANGED IN PLACE)
+#define XOR_MAX_SIZE 6
+#define XOR_RECOVERED 2
+#define GAUSS_MAX_ROWS 2048
+#define GAUSS_MAX_COPIES 32
+
+// --- PORTFOLIO ---
+// LEARNED CLAUSES WITH LBD UP TO SHARE_LBD OR SIZE UP TO SHARE_SIZE ARE SENT
+// TO THE OTHER SOLVERS IF THEY HAVE AT MOST SHARE_MAX_SIZE LITERALS. EACH
+// GOES TO THE EXPORT BUFFER AS ITS SIZE, LBD AND LITERALS.
+// EXPORT_BUFFER_SIZE MUST BE A POWER OF 2
+#define SHARE_LBD 2
+#define SHARE_SIZE 4
+#define SHARE_MAX_SIZE 30
+#define SHARE_MAX_WORDS (SHARE_MAX_SIZE + 2)
+#define EXPORT_BUFFER_SIZE (1 << 16)
+
+// DIVERSIFIED SOLVERS MAY START WITH RANDOM PHASES INSTEAD OF 0 OR 1
+#define PHASE_RANDOM 2
+
+// --- CUBE AND CONQUER ---
+// THE FORMULA IS SPLIT LOG2 OF THE REQUESTED NUMBER OF CUBES DEEP. FOR EVERY
+// SPLIT THE CUBE_CANDIDATES UNASSIGNED VARIABLES WITH THE MOST OCCURRENCES
+// ARE LOOKED AHEAD ON
+#define CUBE_CANDIDATES 16
+
+// --- STATISTICS ---
+// THE CLOCK IS ONLY READ FOR THE PROGRESS REPORT EVERY PROGRESS_CHECK
+// CONFLICTS. PROPAGATION AND ANALYSIS ARE TIMED EVERY TIMING_SAMPLE-TH CALL,
+// AND THE MEASURED TIME IS SCALED UP BY THAT (MUST BE A POWER OF 2)
+#define PROGRESS_CHECK 256
+#define TIMING_SAMPLE 16
+
+// --- PROOF OUTPUT ---
+// BYTES OF BINARY DRAT COLLECTED BEFORE THEY ARE WRITTEN
+#define PROOF_BUFFER_SIZE (1 << 20)
+
+// --- ANSWER OF A BATCH FILE THAT COULDN'T BE SOLVED (SAT IS 1, UNSAT 0) ---
+#define BATCH_ERROR -1
+
+// --- RETURNED BY decide() WHEN ANOTHER SOLVER OF THE PORTFOLIO WAS FASTER ---
+#define SEARCH_STOPPED -1
+
+// --- CLAUSE ARENA ---
+// CLAUSES ARE REFERRED TO BY THEIR OFFSET IN THE ARENA (IN ints),
+// OF THE SOLVER s
+#define CLAUSE(ref) ((clause*)(s->arena + (ref)))
+#define HEADER_WORDS ((int)(sizeof(clause) / sizeof(int)))
+#define CLAUSE_WORDS(size) (HEADER_WORDS + (size))
+#define NEXT_CLAUSE(ref) ((ref) + CLAUSE_WORDS(CLAUSE(ref)->size))
+
+// --- DATA STRUCTURES ---
+
+// CLAUSE HEADER, THE LITERALS FOLLOW IT DIRECTLY IN THE ARENA.
+// THE TWO WATCHED LITERALS ARE ALWAYS literals[0] AND literals[1]
+struct clause {
+    int size;
+
+    // WHILE PREPROCESSING THE CLAUSE'S SIGNATURE, DURING GARBAGE COLLECTION
+    // THE NEW REF OF A RELOCATED CLAUSE
+    int scratch[2];
+
+    unsigned int learned : 1;
+    // DELETED CLAUSES STAY IN THE ARENA UNTIL THE NEXT GARBAGE COLLECTION
+    unsigned int deleted : 1;
+    // SET DURING GARBAGE COLLECTION, THE NEW REF IS THEN IN scratch[0]
+    unsigned int relocated : 1;
+    // LEARNED CLAUSES ARE VIVIFIED ONLY ONCE
+    unsigned int vivified : 1;
+    // EXPLAINS AN IMPLICATION OR A CONFLICT OF THE XORS, SEE add_xor_clause()
+    unsigned int xor_reason : 1;
+
+    // LEARNED CLAUSES ONLY: LITERAL BLOCK DISTANCE (NUMBER OF DIFFERENT
+    // DECISION LEVELS AMONG THE LITERALS) AND ACTIVITY IN CONFLICT ANALYSIS
+    unsigned int lbd : 27;
+    float activity;
+
+    int literals[];
+};
+
+
+// CONTIGUOUS GROWABLE ARRAY OF REFS OF CLAUSES WATCHING A LITERAL
+struct watch_list {
+    int* clause_refs;
+    int size;
+    int capacity;
+};
+
+
+// WHAT THE DIMACS PARSER HAS TO REMEMBER BETWEEN TWO PIECES OF INPUT
+struct parser_state {
+    // WHICH SIGNS OF A VARIABLE ARE IN THE CURRENT CLAUSE: BIT 1 POSITIVE,
+    // BIT 2 NEGATIVE. SIZED BY THE HEADER, GROWN IF THE HEADER LIED
+    char* marks;
+    int marks_size;
+
+    // REF OF THE CLAUSE BEING READ (-1 IF NONE), ITS LITERALS GO AFTER
+    // THE HEADER
+    int clause_start;
+    int clause_count;
+
+    // SET ONCE THE "%" TERMINATOR IS SEEN
+    int done;
+
+    // SIZE OF THE (DECOMPRESSED) INPUT, THE HEADER CAN'T RESERVE MORE
+    long long input_bytes;
+
+    // SET WHILE AN "x" LINE IS READ, ITS LITERALS GO TO xor_literals
+    int in_xor;
+    watch_list xor_literals;
+};
+
+
+// A CLAUSE WATCHING A LITERAL, WITH ANOTHER OF ITS LITERALS. WHEN THE
+// blocker IS TRUE THE CLAUSE IS SATISFIED AND ISN'T LOOKED AT
+struct watcher {
+    int clause_ref;
+    int blocker;
+};
+
+struct watcher_list {
+    watcher* watchers;
+    int size;
+    int capacity;
+};
+
+
+// SOMETHING TO BE SORTED BY compare_entries(): BY primary, THEN secondary,
+// BOTH ASCENDING. THE KEYS ARE COMPUTED BEFORE SORTING, SO THAT THE
+// COMPARISON DOESN'T NEED THE SOLVER
+struct sort_entry {
+    long long primary;
+    double secondary;
+    int value;
+};
+
+
+// ----------------------
+// -----SOLVER STATE-----
+// ----------------------
+
+// EVERYTHING ONE SOLVER INSTANCE WORKS WITH, SO THAT SEVERAL OF THEM CAN RUN
+// AT THE SAME TIME. FUNCTIONS WORKING ON A SOLVER GET IT AS s
+struct solver {
+    // STORAGE FOR CLAUSES AND VARIABLES, PRIMARY DATA
+    // ALL CLAUSES LIVE IN ONE ARENA, ONE AFTER ANOTHER.
+    // arena_wasted COUNTS THE WORDS OCCUPIED BY DELETED CLAUSES
+    int* arena;
+    int arena_size;
+    int arena_capacity;
+    int arena_wasted;
+    int num_variables;
+    int num_clauses;
+
+    // VARIABLE STATE, ONE ARRAY PER PROPERTY SO THAT THE HOT LOOPS ONLY LOAD
+    // WHAT THEY NEED. values IS INDEXED BY THE LITERAL ITSELF (IT POINTS TO
+    // THE MIDDLE OF ITS ALLOCATION): 1 TRUE, -1 FALSE, 0 UNASSIGNED.
+    // THE OTHERS ARE INDEXED BY VARIABLE ID: DECISION LEVEL, ANTECEDENT (SEE
+    // BINARY_ANTECEDENT), VSIDS ACTIVITY AND THE LAST VALUE THE VARIABLE HAD,
+    // WHICH DECISIONS REUSE. ALL OF THEM HAVE ROOM FOR variable_capacity
+    // VARIABLES
+    signed char* values;
+    int* levels;
+    int* antecedents;
+    double* activities;
+    char* saved_phases;
+    int variable_capacity;
+
+    // SET ONCE THE FORMULA IS UNSAT WITHOUT ANY ASSUMPTIONS
+    int inconsistent;
+
+    // LEARNED CLAUSE DATABASE: REFS OF ALL LIVE LEARNED CLAUSES
+    // AND THE CONFLICT COUNT OF THE NEXT REDUCTION
+    int* learned_refs;
+    int learned_count;
+    int learned_capacity;
+    int next_reduce;
+    int reduce_interval;
+    double clause_activity_bump;
+
+    // WATCH LISTS, ONE PER LITERAL (SEE WATCH_INDEX). BINARY CLAUSES ARE
+    // IN binary_watches INSTEAD, AS THE OTHER LITERAL OF THE CLAUSE
+    watcher_list* watches;
+    watch_list* binary_watches;
+
+    // ASSIGNMENT TRAIL: EVERY ASSIGNED LITERAL IN CHRONOLOGICAL ORDER.
+    // LITERALS BEFORE propagation_head HAVE ALREADY HAD THEIR WATCHES VISITED,
+    // THE REST ARE WAITING TO BE PROPAGATED
+    // binary_head IS THE SAME FOR BINARY CLAUSES, WHICH GO FIRST
+    int* trail;
+    int trail_size;
+    int propagation_head;
+    int binary_head;
+
+    // LITERALS OF THE BINARY CLAUSE propagate() FOUND CONFLICTING, AND
+    // THE OTHER LITERAL OF A BINARY ANTECEDENT (SEE reason_literals())
+    int binary_conflict[2];
+    int binary_reason;
+
+    // KEEP TRACK OF WHERE EACH LEVEL'S ASSIGNMENTS START ON THE TRAIL
+    // TO PROPERLY BACKTRACK: level_starts[l] IS THE TRAIL INDEX OF THE
+    // DECISION OF LEVEL l. level_starts AND level_stamps HAVE ROOM FOR
+    // level_capacity LEVELS
+    int* level_starts;
+    int level_capacity;
+
+    // KEEP TRACK OF HOW MUCH VARIABLES ARE LEFT TO ASSIGN
+    int unassigned_count;
+
+    // VSIDS
+    // BINARY MAX-HEAP OF VARIABLE IDS ORDERED BY ACTIVITY,
+    // heap_positions[ID] IS THE INDEX OF THE VARIABLE IN THE HEAP OR -1
+    int* heap;
+    int* heap_positions;
+    int heap_size;
+    double activity_bump;
+
+    // CONFLICT ANALYSIS SCRATCH SPACE, ALLOCATED ONCE AND REUSED:
+    // seen MARKS VARIABLES ALREADY TAKEN INTO ACCOUNT, learned_literals HOLDS
+    // THE CLAUSE BEING LEARNED, analyze_stack AND analyze_to_clear ARE USED BY
+    // THE MINIMIZATION
+    char* seen;
+    int* learned_literals;
+    int* analyze_stack;
+    int* analyze_to_clear;
+    int analyze_to_clear_size;
+
+    // level_stamps[l] == current_stamp MEANS LEVEL l WAS ALREADY COUNTED
+    // WHEN COMPUTING LBD
+    int* level_stamps;
+    int current_stamp;
+
+    // RESTARTS
+    // FOR GLUCOSE RESTARTS THE LBDS OF THE LAST LBD_WINDOW LEARNED CLAUSES ARE
+    // KEPT IN A RING BUFFER, lbd_window_count OF THEM ARE VALID
+    int restart_policy;
+    int conflicts_since_restart;
+    int luby_index;
+    int lbd_window[LBD_WINDOW];
+    int lbd_window_count;
+    long long lbd_window_sum;
+    long long lbd_total_sum;
+
+    // PREPROCESSING
+    // occurrences[WATCH_INDEX(l)] LISTS THE CLAUSES CONTAINING l (DELETED ONES
+    // ARE DROPPED LAZILY), fixed_values HOLDS THE LEVEL 0 VALUES FOUND SO FAR
+    // (-1 FOR NONE) AND fixed_queue THOSE WHOSE CLAUSES ARE STILL TO BE
+    // SIMPLIFIED. THE OTHER QUEUE HOLDS CLAUSES TO TRY SUBSUMING OTHERS WITH.
+    // preprocess_marks IS INDEXED BY WATCH_INDEX, preprocess_buffer IS SCRATCH
+    // SPACE FOR BUILDING CLAUSES. ONLY VARIABLES WHOSE CLAUSES CHANGED SINCE
+    // THE LAST ATTEMPT ARE touched AND TRIED FOR ELIMINATION AGAIN
+    watch_list* occurrences;
+    signed char* fixed_values;
+    watch_list fixed_queue;
+    watch_list subsumption_queue;
+    char* preprocess_marks;
+    char* touched;
+    int* preprocess_buffer;
+    long long preprocess_steps;
+
+    // ELIMINATED VARIABLES ARE MARKED HERE (NULL IF NOTHING WAS PREPROCESSED),
+    // THEIR CLAUSES ARE KEPT ON THE STACK FOR MODEL RECONSTRUCTION: LITERALS,
+    // ELIMINATED ONE FIRST, FOLLOWED BY THE CLAUSE SIZE
+    char* eliminated;
+    watch_list elimination_stack;
+
+    // INPROCESSING (SEE INPROCESS_FIRST), ONLY IF inprocessing IS SET AND THE
+    // SOLVER RUNS ALONE. PROBING CONTINUES AT VARIABLE probe_next, THE
+    // PROPAGATIONS AND TIME OF THE SEARCH ARE COUNTED FROM THE last_inprocess
+    // ONES
+    int inprocessing;
+    long long next_inprocess;
+    long long inprocess_interval;
+    long long last_inprocess_propagations;
+    double last_inprocess_time;
+    int probe_next;
+
+    // LOCAL SEARCH (SEE WALK_FIRST), ONLY IF walking IS SET AND THERE ARE NO
+    // ASSUMPTIONS. ITS BEST ASSIGNMENT BECOMES THE SAVED PHASES
+    int walking;
+    long long next_walk;
+    long long walk_interval;
+    long long last_walk_propagations;
+
+    // XOR CONSTRAINTS, FROM "x" LINES OF THE INPUT OR RECOVERED FROM ITS
+    // CLAUSES IF xor_recovery IS SET. EACH IS IN xors AS ITS SIZE, ITS
+    // PARITY (WHAT ITS VARIABLES XOR TO, PLUS XOR_RECOVERED IF ITS CLAUSES
+    // ARE STILL IN THE FORMULA) AND ITS VARIABLES. THOSE ARE frozen (NULL IF
+    // THERE ARE NO XORS): NEVER ELIMINATED OR SUBSTITUTED. THE SEARCH
+    // PROPAGATES THE XORS WITH ONE MATRIX PER GROUP SHARING VARIABLES.
+    // xor_clauses ARE THE REFS OF THE CLAUSES EXPLAINING WHAT IT DID
+    int xor_recovery;
+    watch_list xors;
+    int num_xors;
+    char* frozen;
+    gauss* matrices;
+    int num_matrices;
+    watch_list xor_clauses;
+
+    // LITERALS decide() HAS TO TAKE AS ITS FIRST DECISIONS. IF THEY CAN'T
+    // ALL BE SATISFIED, THE VARIABLES OF THOSE RESPONSIBLE ARE MARKED failed
+    int* assumptions;
+    int assumption_count;
+    char* failed;
+
+    // CALLBACKS OF THE LIBRARY USER (NULL IF NOT SET): terminate IS ASKED
+    // AFTER EVERY CONFLICT WHETHER TO GIVE UP, learn_callback GETS EVERY
+    // LEARNED CLAUSE OF AT MOST learn_max_length LITERALS
+    int (*terminate)(void* data);
+    void* terminate_data;
+    void (*learn_callback)(void* data, int* clause);
+    void* learn_data;
+    int learn_max_length;
+
+    // DIVERSIFICATION, SO THAT THE SOLVERS OF A PORTFOLIO DON'T ALL SEARCH
+    // ALIKE: INITIAL PHASE (0, 1 OR PHASE_RANDOM) AND THE STATE OF A RANDOM
+    // NUMBER GENERATOR, WHICH IS ONLY USED IF IT IS NOT 0
+    double vsids_decay;
+    int initial_phase;
+    unsigned long long random_state;
+
+    // CLAUSE SHARING (shared IS NULL WHEN SOLVING ALONE).
+    // CLAUSES WORTH SHARING ARE APPENDED TO export_buffer, A RING BUFFER
+    // WRITTEN ONLY BY THIS SOLVER, export_head COUNTS ALL THE WORDS EVER
+    // WRITTEN TO IT. import_positions[i] IS HOW FAR THE BUFFER OF SOLVER i
+    // WAS READ, import_buffer IS WHERE IT IS COPIED TO BEFORE READING
+    portfolio* shared;
+    int id;
+    int* export_buffer;
+    long long export_head;
+    long long* import_positions;
+    int* import_buffer;
+
+    // DRAT PROOF (proof_buffer IS NULL IF NONE IS WRITTEN), SEE proof_add()
+    unsigned char* proof_buffer;
+    int proof_size;
+    int proof_fd;
+
+    // STATISTICS: COUNTERS, TIMES IN SECONDS AND THE PROGRESS REPORT, PRINTED
+    // EVERY progress_interval SECONDS (NEVER IF 0), AS JSON IF json_output
+    int num_learned;
+    int num_deleted;
+    int num_branching;
+    int num_restarts;
+    int num_eliminated;
+    int num_subsumed;
+    int num_strengthened;
+    int num_imported;
+    int num_inprocessings;
+    int num_probed_units;
+    int num_substituted;
+    int num_vivified;
+    int num_walks;
+    long long num_flips;
+    long long num_xor_propagations;
+    long long num_xor_conflicts;
+    long long num_propagations;
+    long long num_conflicts;
+    long long num_timed;
+    double start_time;
+    double parse_seconds;
+    double preprocess_seconds;
+    double propagate_seconds;
+    double analyze_seconds;
+    double progress_interval;
+    double next_progress;
+    long long next_progress_check;
+    int json_output;
+};
+
+// SOLVERS RUNNING ON THE SAME FORMULA IN PARALLEL. stop IS SET AS SOON AS
+// ONE OF THEM HAS AN ANSWER, winner IS ITS INDEX (-1 UNTIL THEN).
+// IN CUBE AND CONQUER MODE THEY ALSO SHARE THE CUBES
+struct portfolio {
+    solver** solvers;
+    int num_solvers;
+    int stop;
+    int winner;
+    int result;
+    cube_pool* cubes;
+};
+
+// CUBES FOR CUBE AND CONQUER: CUBE i IS literals[starts[i]] UP TO
+// literals[starts[i + 1] - 1]. WORKER w TAKES CUBES FROM THE FRONT OF ITS
+// RANGE next[w] TO end[w] - 1, GUARDED BY locks[w]. A WORKER WHOSE RANGE IS
+// EMPTY STEALS THE BACK HALF OF ANOTHER ONE'S
+struct cube_pool {
+    watch_list literals;
+    watch_list starts;
+    int count;
+    int* next;
+    int* end;
+    pthread_mutex_t* locks;
+    int done;
+};
+
+// FILES SOLVED BY A POOL OF WORKERS (SEE solve_batch()). next IS THE FIRST
+// FILE NO WORKER TOOK YET. FOR FILE i, answers[i] IS 1 FOR SAT, 0 FOR UNSAT
+// OR BATCH_ERROR, seconds[i] AND conflicts[i] ARE WHAT SOLVING IT TOOK
+struct batch {
+    char** paths;
+    int count;
+    int capacity;
+    int next;
+    const solver* options;
+    int use_preprocessing;
+    int* answers;
+    double* seconds;
+    long long* conflicts;
+};
+
+// LOCAL SEARCH STATE OVER THE IRREDUNDANT CLAUSES, SIMPLIFIED BY LEVEL 0.
+// CLAUSE i IS literals[clause_starts[i]] UP TO literals[clause_starts[i + 1]
+// - 1], THE CLAUSES WITH LITERAL l ARE occurrences[occurrence_starts[
+// WATCH_INDEX(l)]] UP TO BEFORE occurrence_starts[WATCH_INDEX(l) + 1].
+// values HOLDS THE ASSIGNMENT (1 TRUE, 0 FALSE) BY VARIABLE ID. FOR EACH
+// CLAUSE true_counts COUNTS ITS TRUE LITERALS AND true_variables IS THE XOR
+// OF THEIR VARIABLES, WHICH IS THE ONLY ONE WHEN THERE IS ONE. breaks[v] IS
+// HOW MANY CLAUSES HAVE ONLY v TRUE. THE FALSE CLAUSES ARE LISTED IN
+// false_clauses, false_positions[i] IS WHERE CLAUSE i IS IN THAT LIST.
+// best IS THE ASSIGNMENT WITH THE FEWEST FALSE CLAUSES, best_false OF THEM.
+// THE VARIABLES WHOSE VALUE DIFFERS FROM best ARE LISTED IN unsaved, AT
+// unsaved_positions[ID] (-1 FOR THE OTHERS)
+struct walker {
+    int num_clauses;
+    int* clause_starts;
+    int* literals;
+    int* occurrence_starts;
+    int* occurrences;
+    char* values;
+    int* true_counts;
+    int* true_variables;
+    int* breaks;
+    int* false_clauses;
+    int* false_positions;
+    int false_count;
+    char* best;
+    int best_false;
+    int* unsaved;
+    int* unsaved_positions;
+    int unsaved_count;
+    double probabilities[WALK_BREAK_LIMIT];
+};
+
+// GAUSSIAN ELIMINATION OVER THE XORS OF ONE GROUP. ROW r OF A COPY IS
+// words 64-BIT WORDS, BIT c SET IF IT HAS COLUMN c, WHICH IS VARIABLE
+// variables[c]. THE XOR OF THE VARIABLES OF THE ROW IS parities[r], ITS
+// PIVOT IS A COLUMN NO OTHER ROW HAS (-1 IF IT HAS NONE). COPY i IS THE
+// MATRIX AS DECISION LEVEL levels[i] LEFT IT, rows, parities AND pivots
+// HOLD count OF THEM ONE AFTER ANOTHER, THE LAST ONE IS THE CURRENT ONE.
+// COPY 0 IS THE ORIGINAL, ITS LEVEL IS -1. free_mask AND true_mask ARE
+// SCRATCH SPACE FOR THE ASSIGNMENT OF THE COLUMNS
+struct gauss {
+    int num_rows;
+    int num_columns;
+    int words;
+    int* variables;
+    unsigned long long* rows;
+    char* parities;
+    int* pivots;
+    int* levels;
+    int count;
+    int capacity;
+    unsigned long long* free_mask;
+    unsigned long long* true_mask;
+};
+
+// ---FUNCTION DECLARATIONS AND SHORT IMPLEMENTATIONS---
+solver* new_solver(void);
+void set_defaults(solver* s);
+void reset_solver(solver* s);
+void init_search(solver* s);
+void add_variables(solver* s, int max_variable);
+void reserve_levels(solver* s);
+void backtrack_to_root(solver* s);
+int add_clause(solver* s, const int* literals, int size);
+void analyze_final(solver* s, int literal);
+void free_solver(solver* s);
+int parse_cnf(solver* s, const char* cnf_path);
+int parse_compressed(solver* s, const char* cnf_path, const char* decompressor,
+        long long input_bytes);
+void start_parsing(solver* s, parser_state* state, long long input_bytes);
+int parse_dimacs(solver* s, parser_state* state,
+        const char* pos, const char* end);
+int finish_parsing(solver* s, parser_state* state, int ok);
+void grow_marks(parser_state* state, int max_variable);
+int finish_parsed_clause(solver* s, int clause_start, char* marks);
+int finish_parsed_xor(solver* s, parser_state* state);
+char* solution_filename(const char* cnf_path);
+int write_solution(solver* s, const char* solution_path, int sat);
+int decide(solver* s);
+int assign_units(solver* s);
+void assign(solver* s, int variable_id, int decision_level, int assignment);
+int propagate(solver* s, int decision_level);
+void backtrack(solver* s, int decision_level);
+int replace_watched(solver* s, watcher* entry, int to_replace,
+        int decision_level);
+int learn(solver* s, int conflict, int decision_level);
+int first_uip(solver* s, int conflict, int decision_level);
+int literal_redundant(solver* s, int literal, unsigned int level_mask);
+int compute_lbd(solver* s, int* literals, int size);
+void bump_clause_activity(solver* s, int clause_ref);
+void reduce_learned(solver* s);
+void detach_deleted(solver* s);
+int reserve_arena(solver* s, long long words);
+int allocate_clause(solver* s, int size);
+void collect_garbage(solver* s);
+void watch_clause(solver* s, int clause_ref, int literal, int blocker);
+void attach_clause(solver* s, int clause_ref);
+int* reason_literals(solver* s, int reason, int* size);
+void push_int(watch_list* list, int value);
+int preprocess(solver* s);
+void reconstruct_model(solver* s);
+void heap_insert(solver* s, int variable_id);
+int heap_pop(solver* s);
+void bump_activity(solver* s, int variable_id);
+void decay_activities(solver* s);
+void record_learned_lbd(solver* s, int lbd);
+int restart_due(solver* s);
+unsigned int next_random(solver* s);
+unsigned int xorshift(unsigned long long* state);
+int inprocess_due(solver* s);
+int inprocess(solver* s);
+int probe_literals(solver* s, long long search_propagations);
+int probe(solver* s, int literal);
+int find_equivalences(solver* s, int* representatives);
+int rewrite_clauses(solver* s, int* representatives);
+int vivify_learned(solver* s, double search_seconds);
+void rebuild_heap(solver* s);
+int walk_due(solver* s);
+int walk(solver* s, long long max_flips);
+int solve_local_search(solver* s);
+void start_walk(solver* s, walker* w);
+void walk_flip(walker* w, int variable_id);
+int walk_pick(walker* w, int clause_index, unsigned long long* random);
+void save_best_walk(walker* w);
+void take_walk_model(solver* s, walker* w);
+void free_walker(walker* w);
+void add_xor(solver* s, const int* variables, int size, int parity);
+int recover_xors(solver* s);
+int* group_xors(solver* s);
+void freeze_xor_variables(solver* s);
+int xors_satisfied(solver* s, const char* values);
+void start_gauss(solver* s);
+void gauss_copy(gauss* g, int decision_level);
+int gauss_propagate(solver* s, int decision_level);
+int gauss_update(solver* s, gauss* g, int decision_level);
+int add_xor_clause(solver* s, gauss* g, unsigned long long* row,
+        int implied, int decision_level);
+void delete_xor_clauses(solver* s);
+void free_xors(solver* s);
+int solve_portfolio(solver* s, int num_threads);
+int solve_cubes(solver* s, int num_threads, int num_cubes);
+void export_clause(solver* s, int* literals, int size, int lbd);
+int import_clauses(solver* s);
+void remember_learned(solver* s, int clause_ref);
+int add_batch_input(batch* b, const char* path);
+void add_batch_path(batch* b, const char* path);
+int compare_paths(const void* a, const void* b);
+void solve_batch_file(batch* b, solver* s, int index);
+void* batch_worker(void* argument);
+int solve_batch(batch* b, const solver* options, int num_threads,
+        int use_preprocessing);
+void free_batch(batch* b);
+double seconds_now(void);
+void check_progress(solver* s);
+void print_statistics(solver* s, int final);
+int open_proof(solver* s, const char* path);
+void flush_proof(solver* s);
+void close_proof(solver* s);
+void write_proof(solver* s, unsigned char kind, const int* literals,
+        int size);
+void proof_add(solver* s, const int* literals, int size);
+void proof_delete(solver* s, const int* literals, int size);
+
+#endif